@@ -0,0 +1,42 @@
+#ifndef TLIB_BENCH_H
+#define TLIB_BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Timing helpers shared by the benchmark executables. Build them with
+// optimization, e.g. cmake -DCMAKE_BUILD_TYPE=Release.
+namespace bench {
+
+// Store a result where the optimizer cannot see it, so the work that
+// produced it is kept
+inline void keep(std::size_t p_x) {
+  static volatile std::size_t sink;
+  sink = p_x;
+  (void)sink;
+}
+
+// Best of p_reps runs of p_fn, in nanoseconds per operation, where one run
+// performs p_ops operations
+template <typename F>
+double ns_per_op(F p_fn, std::size_t p_ops, int p_reps = 5) {
+  double best = 0;
+  for (int r = 0; r < p_reps; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    p_fn();
+    const std::chrono::duration<double, std::nano> took =
+        std::chrono::steady_clock::now() - start;
+    if (r == 0 || took.count() < best)
+      best = took.count();
+  }
+  return best / p_ops;
+}
+
+inline void report(const char *p_name, std::size_t p_n, double p_ns) {
+  std::printf("%-32s n=%-9zu %10.2f ns/op\n", p_name, p_n, p_ns);
+}
+
+} // namespace bench
+
+#endif // TLIB_BENCH_H
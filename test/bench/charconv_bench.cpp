@@ -0,0 +1,97 @@
+// Number formatting and parsing against snprintf, strtoll and strtod
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "tlib/charconv.h"
+#include "tlib/string.h"
+
+int main() {
+  const std::size_t n = 1 << 20;
+  std::mt19937_64 rng(1);
+  // Integers of every magnitude, and doubles both short and full precision
+  std::vector<long long> ints(n);
+  for (auto &x : ints)
+    x = static_cast<long long>(rng()) >> (rng() % 64);
+  std::vector<double> doubles(n);
+  std::uniform_real_distribution<double> uni(-1e6, 1e6);
+  for (std::size_t i = 0; i < n; ++i)
+    doubles[i] = i % 2 ? uni(rng) : static_cast<double>(rng() % 100000) / 100;
+
+  char buf[64];
+  bench::report("snprintf %lld", n, bench::ns_per_op([&] {
+                  std::size_t len = 0;
+                  for (long long x : ints)
+                    len += std::snprintf(buf, sizeof(buf), "%lld", x);
+                  bench::keep(len);
+                }, n));
+  bench::report("write_int", n, bench::ns_per_op([&] {
+                  std::size_t len = 0;
+                  for (long long x : ints)
+                    len += tlib::write_int(buf, x) - buf;
+                  bench::keep(len);
+                }, n));
+  bench::report("snprintf %.17g", n, bench::ns_per_op([&] {
+                  std::size_t len = 0;
+                  for (double x : doubles)
+                    len += std::snprintf(buf, sizeof(buf), "%.17g", x);
+                  bench::keep(len);
+                }, n));
+  bench::report("write_double", n, bench::ns_per_op([&] {
+                  std::size_t len = 0;
+                  for (double x : doubles)
+                    len += tlib::write_double(buf, x) - buf;
+                  bench::keep(len);
+                }, n));
+
+  // Building one line of numbers
+  bench::report("snprintf into std::string", n, bench::ns_per_op([&] {
+                  std::string line;
+                  for (long long x : ints)
+                    line.append(buf,
+                                std::snprintf(buf, sizeof(buf), "%lld", x));
+                  bench::keep(line.size());
+                }, n));
+  bench::report("String::append_int", n, bench::ns_per_op([&] {
+                  tlib::String line("");
+                  for (long long x : ints)
+                    line.append_int(x);
+                  bench::keep(line.size());
+                }, n));
+
+  std::vector<std::string> int_text(n), double_text(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    int_text[i] = std::to_string(ints[i]);
+    std::snprintf(buf, sizeof(buf), "%.17g", doubles[i]);
+    double_text[i] = buf;
+  }
+  bench::report("strtoll", n, bench::ns_per_op([&] {
+                  long long sum = 0;
+                  for (const auto &s : int_text)
+                    sum += std::strtoll(s.c_str(), nullptr, 10);
+                  bench::keep(static_cast<std::size_t>(sum));
+                }, n));
+  bench::report("parse_int", n, bench::ns_per_op([&] {
+                  long long sum = 0;
+                  for (const auto &s : int_text)
+                    sum += tlib::parse_int(s.c_str());
+                  bench::keep(static_cast<std::size_t>(sum));
+                }, n));
+  bench::report("strtod", n, bench::ns_per_op([&] {
+                  double sum = 0;
+                  for (const auto &s : double_text)
+                    sum += std::strtod(s.c_str(), nullptr);
+                  bench::keep(static_cast<std::size_t>(sum));
+                }, n));
+  bench::report("parse_double", n, bench::ns_per_op([&] {
+                  double sum = 0;
+                  for (const auto &s : double_text)
+                    sum += tlib::parse_double(s.c_str());
+                  bench::keep(static_cast<std::size_t>(sum));
+                }, n));
+}
@@ -0,0 +1,65 @@
+// Append throughput of ConcurrentVector by thread count, against a Vector
+// behind a mutex
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench/bench.h"
+#include "tlib/concurrent_vector.h"
+#include "tlib/vector.h"
+
+namespace {
+
+// Run p_fn(thread index) on p_threads threads and wait for all of them
+template <typename F> void on_threads(unsigned p_threads, F p_fn) {
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < p_threads; ++t)
+    pool.emplace_back(p_fn, t);
+  for (auto &th : pool)
+    th.join();
+}
+
+} // namespace
+
+// Usage: concurrent_vector_bench [max threads], by default the core count
+int main(int argc, char **argv) {
+  const std::size_t n = 1 << 22; // total appends, split across threads
+  unsigned max_threads = argc > 1 ? std::atoi(argv[1])
+                                  : std::thread::hardware_concurrency();
+  if (max_threads == 0)
+    max_threads = 4;
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+    const std::size_t per_thread = n / threads;
+    std::printf("%u threads\n", threads);
+    bench::report("  Vector + mutex, push_back", n, bench::ns_per_op([&] {
+                    tlib::Vector<std::uint64_t> v(0);
+                    std::mutex lock;
+                    on_threads(threads, [&](unsigned) {
+                      for (std::size_t i = 0; i < per_thread; ++i) {
+                        std::lock_guard<std::mutex> guard(lock);
+                        v.push_back(i);
+                      }
+                    });
+                    bench::keep(v.size());
+                  }, n, 3));
+    bench::report("  ConcurrentVector, push_back", n, bench::ns_per_op([&] {
+                    tlib::ConcurrentVector<std::uint64_t> v;
+                    on_threads(threads, [&](unsigned) {
+                      for (std::size_t i = 0; i < per_thread; ++i)
+                        v.push_back(i);
+                    });
+                    bench::keep(v.size());
+                  }, n, 3));
+    bench::report("  ConcurrentVector, grow_by(64)", n, bench::ns_per_op([&] {
+                    tlib::ConcurrentVector<std::uint64_t> v;
+                    on_threads(threads, [&](unsigned p_t) {
+                      for (std::size_t i = 0; i < per_thread; i += 64)
+                        v.grow_by(64, p_t);
+                    });
+                    bench::keep(v.size());
+                  }, n, 3));
+  }
+}
@@ -0,0 +1,45 @@
+// FlatMap lookups, with and without the Eytzinger index, against std::map
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "bench/bench.h"
+#include "tlib/flat_map.h"
+
+int main() {
+  const std::size_t lookups = 1 << 20;
+  for (std::size_t n : {1u << 10, 1u << 16, 1u << 20}) {
+    std::mt19937_64 rng(n);
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> pairs(n);
+    for (auto &p : pairs)
+      p = {rng(), rng()};
+    std::vector<std::uint64_t> keys(lookups);
+    for (auto &k : keys)
+      k = pairs[rng() % n].first;
+
+    std::map<std::uint64_t, std::uint64_t> tree(pairs.begin(), pairs.end());
+    tlib::FlatMap<std::uint64_t, std::uint64_t> flat(pairs.begin(),
+                                                     pairs.end());
+
+    bench::report("std::map::find", n, bench::ns_per_op([&] {
+                    std::size_t sum = 0;
+                    for (std::uint64_t k : keys)
+                      sum += tree.find(k)->second;
+                    bench::keep(sum);
+                  }, lookups));
+    bench::report("FlatMap::find", n, bench::ns_per_op([&] {
+                    std::size_t sum = 0;
+                    for (std::uint64_t k : keys)
+                      sum += *flat.find(k);
+                    bench::keep(sum);
+                  }, lookups));
+    flat.build_index();
+    bench::report("FlatMap::find, Eytzinger", n, bench::ns_per_op([&] {
+                    std::size_t sum = 0;
+                    for (std::uint64_t k : keys)
+                      sum += *flat.find(k);
+                    bench::keep(sum);
+                  }, lookups));
+  }
+}
@@ -0,0 +1,64 @@
+// Hash throughput by input length against std::hash
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "tlib/hash.h"
+
+int main() {
+  std::mt19937_64 rng(1);
+  for (std::size_t len : {4u, 8u, 16u, 32u, 64u, 256u, 4096u, 1u << 20}) {
+    // Enough distinct inputs to cover about 64 MiB, at least 64 of them
+    const std::size_t count = len < (1 << 20) ? (1 << 26) / len : 64;
+    const std::size_t inputs = count < 4096 ? count : 4096;
+    std::vector<std::string> strs(inputs);
+    for (auto &s : strs) {
+      s.resize(len);
+      for (auto &c : s)
+        c = static_cast<char>(rng());
+    }
+
+    const double ours = bench::ns_per_op([&] {
+      std::size_t h = 0;
+      for (std::size_t i = 0; i < count; ++i) {
+        const std::string &s = strs[i % inputs];
+        h ^= tlib::hash_bytes(s.data(), s.size());
+      }
+      bench::keep(h);
+    }, count);
+    const double theirs = bench::ns_per_op([&] {
+      std::hash<std::string> hasher;
+      std::size_t h = 0;
+      for (std::size_t i = 0; i < count; ++i)
+        h ^= hasher(strs[i % inputs]);
+      bench::keep(h);
+    }, count);
+    bench::report("hash_bytes", len, ours);
+    bench::report("std::hash<std::string>", len, theirs);
+    std::printf("%-32s %.2f vs %.2f GB/s\n", "", len / ours, len / theirs);
+  }
+
+  // Integer keys, as for an UnorderedMap<uint64_t, ...>
+  const std::size_t n = 1 << 24;
+  std::vector<std::uint64_t> keys(4096);
+  for (auto &k : keys)
+    k = rng();
+  bench::report("Hash<uint64_t>", n, bench::ns_per_op([&] {
+                  tlib::Hash<std::uint64_t> hasher;
+                  std::size_t h = 0;
+                  for (std::size_t i = 0; i < n; ++i)
+                    h += hasher(keys[i % keys.size()] ^ h);
+                  bench::keep(h);
+                }, n));
+  bench::report("std::hash<uint64_t>", n, bench::ns_per_op([&] {
+                  std::hash<std::uint64_t> hasher;
+                  std::size_t h = 0;
+                  for (std::size_t i = 0; i < n; ++i)
+                    h += hasher(keys[i % keys.size()] ^ h);
+                  bench::keep(h);
+                }, n));
+}
@@ -0,0 +1,102 @@
+// LruCache under Zipfian access against the usual std::list plus
+// std::unordered_map LRU
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "bench/bench.h"
+#include "tlib/hash.h"
+#include "tlib/lru_cache.h"
+
+namespace {
+
+class ListLru {
+private:
+  using Entry = std::pair<std::uint64_t, std::uint64_t>;
+  std::size_t m_capacity;
+  std::list<Entry> m_order; // most recently used first
+  std::unordered_map<std::uint64_t, std::list<Entry>::iterator> m_index;
+
+public:
+  ListLru(std::size_t p_capacity) : m_capacity(p_capacity) {}
+
+  std::uint64_t *get(std::uint64_t p_key) {
+    auto it = m_index.find(p_key);
+    if (it == m_index.end())
+      return nullptr;
+    m_order.splice(m_order.begin(), m_order, it->second);
+    return &it->second->second;
+  }
+
+  void put(std::uint64_t p_key, std::uint64_t p_val) {
+    m_order.emplace_front(p_key, p_val);
+    m_index[p_key] = m_order.begin();
+    if (m_order.size() > m_capacity) {
+      m_index.erase(m_order.back().first);
+      m_order.pop_back();
+    }
+  }
+};
+
+// Keys drawn with probability proportional to 1 / rank^p_skew
+std::vector<std::uint64_t> zipf_keys(std::size_t p_keys, double p_skew,
+                                     std::size_t p_n) {
+  std::vector<double> cdf(p_keys);
+  double sum = 0;
+  for (std::size_t i = 0; i < p_keys; ++i) {
+    sum += 1.0 / std::pow(static_cast<double>(i + 1), p_skew);
+    cdf[i] = sum;
+  }
+  std::mt19937_64 rng(p_keys);
+  std::uniform_real_distribution<double> uni(0, sum);
+  std::vector<std::uint64_t> out(p_n);
+  for (auto &k : out)
+    k = std::lower_bound(cdf.begin(), cdf.end(), uni(rng)) - cdf.begin();
+  return out;
+}
+
+// Look up each key and insert it on a miss; returns the hit ratio
+template <typename Cache>
+double replay(Cache &p_cache, const std::vector<std::uint64_t> &p_keys) {
+  std::size_t hits = 0;
+  for (std::uint64_t k : p_keys) {
+    if (p_cache.get(k))
+      ++hits;
+    else
+      p_cache.put(k, k);
+  }
+  return double(hits) / p_keys.size();
+}
+
+} // namespace
+
+int main() {
+  const std::size_t keys = 1 << 20, n = 1 << 22;
+  for (double skew : {0.8, 0.99, 1.2}) {
+    const std::vector<std::uint64_t> trace = zipf_keys(keys, skew, n);
+    for (std::size_t cap : {keys / 100, keys / 10}) {
+      std::printf("skew %.2f, capacity %zu\n", skew, cap);
+      double ratio = 0;
+      bench::report("  std::list + unordered_map", n, bench::ns_per_op([&] {
+                      ListLru c(cap);
+                      ratio = replay(c, trace);
+                    }, n, 3));
+      bench::report("  LruCache", n, bench::ns_per_op([&] {
+                      tlib::LruCache<std::uint64_t, std::uint64_t> c(cap);
+                      ratio = replay(c, trace);
+                    }, n, 3));
+      bench::report("  LruCache, tlib::Hash", n, bench::ns_per_op([&] {
+                      tlib::LruCache<std::uint64_t, std::uint64_t,
+                                     tlib::Hash<std::uint64_t>>
+                          c(cap);
+                      ratio = replay(c, trace);
+                    }, n, 3));
+      std::printf("  hit ratio %.3f\n", ratio);
+    }
+  }
+}
@@ -0,0 +1,76 @@
+// radix_sort and network_sort against std::sort, across sizes and input
+// distributions
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bench/bench.h"
+#include "tlib/sort.h"
+
+namespace {
+
+enum class Dist { uniform, few_unique, sorted };
+
+template <typename T> T draw(std::mt19937_64 &p_rng, Dist p_dist) {
+  if (p_dist == Dist::few_unique)
+    return static_cast<T>(p_rng() % 16);
+  std::uniform_real_distribution<double> uni(-1e6, 1e6);
+  return std::is_floating_point<T>::value ? static_cast<T>(uni(p_rng))
+                                          : static_cast<T>(p_rng());
+}
+
+// Sort enough copies of an n-element input to cover about a million
+// elements, restoring the input before each sort
+template <typename T>
+void run(const char *p_type, Dist p_dist, const char *p_dist_name,
+         std::size_t p_n) {
+  std::mt19937_64 rng(p_n);
+  std::vector<T> src(p_n);
+  for (auto &x : src)
+    x = draw<T>(rng, p_dist);
+  if (p_dist == Dist::sorted)
+    std::sort(src.begin(), src.end());
+  const std::size_t rounds = p_n < (1 << 20) ? (1 << 20) / p_n : 1;
+  tlib::Vector<T> v(p_n), scratch(0);
+  auto restore = [&] {
+    std::memcpy(v.data(), src.data(), p_n * sizeof(T));
+  };
+  const std::string tag =
+      std::string(p_type) + ", " + p_dist_name + ", ";
+
+  auto time = [&](const char *p_name, std::function<void()> p_sort) {
+    const double ns = bench::ns_per_op([&] {
+      for (std::size_t r = 0; r < rounds; ++r) {
+        restore();
+        p_sort();
+      }
+      bench::keep(static_cast<std::size_t>(v.data()[p_n / 2]));
+    }, rounds * p_n);
+    bench::report((tag + p_name).c_str(), p_n, ns);
+  };
+  time("std::sort", [&] { std::sort(v.data(), v.data() + p_n); });
+  time("radix_sort", [&] { tlib::radix_sort(v, scratch); });
+  if (p_n <= _SORT_NETWORK_MAX)
+    time("network_sort", [&] { tlib::network_sort(v.data(), p_n); });
+}
+
+template <typename T> void run_all(const char *p_type) {
+  for (std::size_t n : {16u, 32u, 1u << 10, 1u << 16, 1u << 20}) {
+    run<T>(p_type, Dist::uniform, "uniform", n);
+    run<T>(p_type, Dist::few_unique, "few unique", n);
+    run<T>(p_type, Dist::sorted, "sorted", n);
+  }
+}
+
+} // namespace
+
+int main() {
+  run_all<std::uint32_t>("u32");
+  run_all<std::uint64_t>("u64");
+  run_all<float>("float");
+}
@@ -0,0 +1,170 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+
+#include "tlib/bit_vector.h"
+
+using tlib::BitVector;
+
+TEST(BitVectorTest, Constructor) {
+  BitVector b;
+  ASSERT_TRUE(b.empty());
+  ASSERT_EQ(b.count(), 0);
+
+  BitVector b1(100);
+  ASSERT_EQ(b1.size(), 100);
+  ASSERT_EQ(b1.num_words(), 2);
+  ASSERT_EQ(b1.count(), 0);
+
+  BitVector b2(100, true);
+  ASSERT_EQ(b2.count(), 100);
+  ASSERT_TRUE(b2[99]);
+  ASSERT_ANY_THROW(b2[100]);
+}
+
+TEST(BitVectorTest, SetResetFlip) {
+  BitVector b(130);
+  b.set(0);
+  b.set(64);
+  b.set(129);
+  ASSERT_TRUE(b.test(0));
+  ASSERT_TRUE(b[64]);
+  ASSERT_FALSE(b[65]);
+  ASSERT_EQ(b.count(), 3);
+
+  b.reset(64);
+  b.flip(1);
+  ASSERT_FALSE(b[64]);
+  ASSERT_TRUE(b[1]);
+  ASSERT_EQ(b.count(), 3);
+  ASSERT_ANY_THROW(b.set(130));
+
+  b.flip_all();
+  ASSERT_EQ(b.count(), 127);
+  b.reset_all();
+  ASSERT_TRUE(b.none());
+  b.set_all();
+  ASSERT_EQ(b.count(), 130);
+}
+
+TEST(BitVectorTest, Resize) {
+  BitVector b(10, true);
+  b.resize(100);
+  ASSERT_EQ(b.count(), 10);
+  b.resize(200, true);
+  ASSERT_EQ(b.count(), 110);
+  ASSERT_FALSE(b[99]);
+  ASSERT_TRUE(b[100]);
+  b.resize(5);
+  ASSERT_EQ(b.count(), 5);
+
+  b.push_back(true);
+  b.push_back(false);
+  ASSERT_EQ(b.size(), 7);
+  ASSERT_EQ(b.count(), 6);
+}
+
+// Appending a bit at a time grows the word array geometrically, so this
+// stays fast across many words
+TEST(BitVectorTest, PushBackManyWords) {
+  const std::size_t n = std::size_t(1) << 24;
+  BitVector b;
+  for (std::size_t i = 0; i < n; ++i)
+    b.push_back(i % 3 == 0);
+  ASSERT_EQ(b.size(), n);
+  ASSERT_EQ(b.num_words(), n / 64);
+  ASSERT_EQ(b.count(), (n + 2) / 3);
+  for (std::size_t i : {std::size_t(0), std::size_t(64), std::size_t(65),
+                        n / 2, n - 1})
+    ASSERT_EQ(b[i], i % 3 == 0);
+
+  // Interleaved resize() keeps the invariants
+  b.resize(n + 10, true);
+  b.push_back(false);
+  ASSERT_EQ(b.size(), n + 11);
+  ASSERT_EQ(b.count(), (n + 2) / 3 + 10);
+}
+
+// The popcnt path, when the CPU has it, and the portable one agree
+TEST(BitVectorTest, PopcountWords) {
+  std::mt19937_64 rng(3);
+  std::uint64_t words[100];
+  for (auto &w : words)
+    w = rng() & rng();
+  words[0] = 0;
+  words[1] = ~std::uint64_t(0);
+  std::size_t expected = 0;
+  for (std::uint64_t w : words)
+    for (int b = 0; b < 64; b++)
+      expected += (w >> b) & 1;
+  ASSERT_EQ(tlib::popcount_words(words, 100), expected);
+  ASSERT_EQ(tlib::bit_detail::popcount_words_generic(words, 100), expected);
+  ASSERT_EQ(tlib::popcount_words(words, 0), 0);
+}
+
+TEST(BitVectorTest, BitwiseOps) {
+  BitVector a(200), b(200);
+  for (std::size_t i = 0; i < 200; i += 2)
+    a.set(i);
+  for (std::size_t i = 0; i < 200; i += 3)
+    b.set(i);
+
+  auto both = a & b;
+  auto either = a | b;
+  auto one = a ^ b;
+  for (std::size_t i = 0; i < 200; i++) {
+    ASSERT_EQ(both[i], i % 6 == 0);
+    ASSERT_EQ(either[i], i % 2 == 0 || i % 3 == 0);
+    ASSERT_EQ(one[i], (i % 2 == 0) != (i % 3 == 0));
+  }
+  ASSERT_EQ((~a).count(), 100);
+  ASSERT_TRUE((a ^ a).none());
+  ASSERT_TRUE((a | b) == (b | a));
+
+  BitVector c(10);
+  ASSERT_ANY_THROW(a &= c);
+}
+
+TEST(BitVectorTest, FindFirstNext) {
+  BitVector b(1000);
+  ASSERT_EQ(b.find_first(), BitVector::npos);
+  b.set(3);
+  b.set(64);
+  b.set(999);
+  ASSERT_EQ(b.find_first(), 3);
+  ASSERT_EQ(b.find_next(3), 64);
+  ASSERT_EQ(b.find_next(64), 999);
+  ASSERT_EQ(b.find_next(999), BitVector::npos);
+}
+
+TEST(BitVectorTest, RankSelect) {
+  std::mt19937 rng(7);
+  BitVector b(10000);
+  for (int i = 0; i < 3000; i++)
+    b.set(rng() % 10000);
+
+  const std::size_t total = b.count();
+  tlib::Vector<std::size_t> positions(0);
+  for (auto i = b.find_first(); i != BitVector::npos; i = b.find_next(i))
+    positions.push_back(i);
+  ASSERT_EQ(positions.size(), total);
+
+  for (int indexed = 0; indexed < 2; indexed++) {
+    if (indexed)
+      b.build_rank_index();
+    ASSERT_EQ(b.has_rank_index(), indexed == 1);
+
+    std::size_t n = 0;
+    for (std::size_t i = 0; i <= b.size(); i++) {
+      ASSERT_EQ(b.rank(i), n);
+      if (i < b.size() && b[i])
+        n++;
+    }
+    for (std::size_t k = 0; k < total; k++)
+      ASSERT_EQ(b.select(k), positions[k]);
+    ASSERT_EQ(b.select(total), BitVector::npos);
+  }
+
+  b.set(positions[0] + 1 == positions[1] ? 0 : positions[0] + 1);
+  ASSERT_FALSE(b.has_rank_index());
+}
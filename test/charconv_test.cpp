@@ -0,0 +1,124 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+#include "tlib/charconv.h"
+
+static std::string format_double(double v) {
+  char buf[_FLOAT_CHARS];
+  return std::string(buf, tlib::write_double(buf, v));
+}
+
+static std::string format_float(float v) {
+  char buf[_FLOAT_CHARS];
+  return std::string(buf, tlib::write_float(buf, v));
+}
+
+TEST(CharconvTest, WriteInt) {
+  char buf[32];
+  for (long long v : {0LL, 9LL, 10LL, 99LL, 100LL, -1LL, -100LL,
+                      123456789012345LL,
+                      std::numeric_limits<long long>::max(),
+                      std::numeric_limits<long long>::min()}) {
+    char *end = tlib::write_int(buf, v);
+    *end = '\0';
+    ASSERT_EQ(static_cast<std::size_t>(end - buf), tlib::int_length(v));
+    ASSERT_EQ(std::strtoll(buf, nullptr, 10), v);
+  }
+  char *end = tlib::write_int(buf, static_cast<unsigned char>(255));
+  ASSERT_EQ(std::string(buf, end), "255");
+
+  // Types narrower than int are promoted during negation
+  end = tlib::write_int(buf, static_cast<short>(-1));
+  ASSERT_EQ(std::string(buf, end), "-1");
+  ASSERT_EQ(tlib::int_length(static_cast<short>(-1)), 2);
+  end = tlib::write_int(buf, std::numeric_limits<short>::min());
+  ASSERT_EQ(std::string(buf, end), "-32768");
+  end = tlib::write_int(buf, static_cast<std::int8_t>(-5));
+  ASSERT_EQ(std::string(buf, end), "-5");
+  end = tlib::write_int(buf, static_cast<std::int8_t>(INT8_MIN));
+  ASSERT_EQ(std::string(buf, end), "-128");
+  ASSERT_EQ(tlib::int_length(static_cast<std::int8_t>(INT8_MIN)), 4);
+}
+
+TEST(CharconvTest, WriteDoubleFormat) {
+  ASSERT_EQ(format_double(0.0), "0");
+  ASSERT_EQ(format_double(-0.0), "-0");
+  ASSERT_EQ(format_double(1.0), "1");
+  ASSERT_EQ(format_double(100.0), "100");
+  ASSERT_EQ(format_double(0.1), "0.1");
+  ASSERT_EQ(format_double(0.3), "0.3");
+  ASSERT_EQ(format_double(123.456), "123.456");
+  ASSERT_EQ(format_double(1e20), "100000000000000000000");
+  ASSERT_EQ(format_double(1e21), "1e+21");
+  ASSERT_EQ(format_double(1e-6), "0.000001");
+  ASSERT_EQ(format_double(1e-7), "1e-7");
+  ASSERT_EQ(format_double(5e-324), "5e-324");
+  ASSERT_EQ(format_double(1.7976931348623157e308), "1.7976931348623157e+308");
+  ASSERT_EQ(format_double(std::numeric_limits<double>::infinity()), "inf");
+  ASSERT_EQ(format_double(-std::numeric_limits<double>::infinity()), "-inf");
+  ASSERT_EQ(format_double(std::nan("")), "nan");
+}
+
+TEST(CharconvTest, DoubleRoundTrip) {
+  std::mt19937_64 rng(123);
+  for (int i = 0; i < 200000; i++) {
+    std::uint64_t bits = rng();
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    if (!std::isfinite(v))
+      continue;
+    const std::string s = format_double(v);
+    ASSERT_EQ(std::strtod(s.c_str(), nullptr), v) << s;
+    ASSERT_EQ(tlib::parse_double(s.c_str()), v) << s;
+  }
+}
+
+TEST(CharconvTest, FloatRoundTrip) {
+  ASSERT_EQ(format_float(0.1f), "0.1");
+  ASSERT_EQ(format_float(1.0f / 3), "0.33333334");
+  std::mt19937 rng(321);
+  for (int i = 0; i < 200000; i++) {
+    std::uint32_t bits = rng();
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    if (!std::isfinite(v))
+      continue;
+    const std::string s = format_float(v);
+    ASSERT_EQ(std::strtof(s.c_str(), nullptr), v) << s;
+  }
+}
+
+TEST(CharconvTest, ParseInt) {
+  ASSERT_EQ(tlib::parse_int("0"), 0);
+  ASSERT_EQ(tlib::parse_int("+15"), 15);
+  ASSERT_EQ(tlib::parse_int("-9223372036854775808"),
+            std::numeric_limits<long long>::min());
+  ASSERT_EQ(tlib::parse_int("9223372036854775807"),
+            std::numeric_limits<long long>::max());
+  ASSERT_THROW(tlib::parse_int("9223372036854775808"), std::out_of_range);
+  ASSERT_THROW(tlib::parse_int(""), std::invalid_argument);
+  ASSERT_THROW(tlib::parse_int("-"), std::invalid_argument);
+  ASSERT_THROW(tlib::parse_int("1 "), std::invalid_argument);
+}
+
+TEST(CharconvTest, ParseDouble) {
+  const char *inputs[] = {"0",         "1",           "-2.5",
+                          "0.1",       "3.14159",     "1e10",
+                          "1E-5",      "123456789012345678901234",
+                          "0.000001",  "1.7976931348623157e308",
+                          "5e-324",    "2.2250738585072014e-308",
+                          ".5",        "5.",          "inf"};
+  for (const char *in : inputs) {
+    ASSERT_EQ(tlib::parse_double(in), std::strtod(in, nullptr)) << in;
+  }
+  ASSERT_THROW(tlib::parse_double(""), std::invalid_argument);
+  ASSERT_THROW(tlib::parse_double("1e"), std::invalid_argument);
+  ASSERT_THROW(tlib::parse_double("."), std::invalid_argument);
+  ASSERT_THROW(tlib::parse_double("1.0x"), std::invalid_argument);
+}
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "tlib/concurrent_vector.h"
+
+using tlib::ConcurrentVector;
+
+TEST(ConcurrentVectorTest, Constructor) {
+  ConcurrentVector<int> v;
+  ASSERT_TRUE(v.empty());
+  ASSERT_EQ(v.size(), 0);
+  ASSERT_EQ(v.capacity(), 0);
+  ASSERT_EQ(v.begin(), v.end());
+  ASSERT_ANY_THROW(v[0]);
+  ASSERT_ANY_THROW(v.front());
+}
+
+TEST(ConcurrentVectorTest, PushBack) {
+  ConcurrentVector<int> v;
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(v.push_back(i), i);
+  ASSERT_EQ(v.size(), 1000);
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(v[i], i);
+  ASSERT_EQ(v.front(), 0);
+  ASSERT_ANY_THROW(v[1000]);
+
+  int expected = 0;
+  for (int x : v)
+    ASSERT_EQ(x, expected++);
+  ASSERT_EQ(expected, 1000);
+}
+
+TEST(ConcurrentVectorTest, GrowBy) {
+  ConcurrentVector<int> v;
+  v.push_back(1);
+  // Spans the first few segments
+  ASSERT_EQ(v.grow_by(100, 7), 1);
+  ASSERT_EQ(v.grow_by(0), 101);
+  ASSERT_EQ(v.grow_by(3), 101);
+  ASSERT_EQ(v.size(), 104);
+  ASSERT_EQ(v[0], 1);
+  for (int i = 1; i < 101; ++i)
+    ASSERT_EQ(v[i], 7);
+  ASSERT_EQ(v[103], 0);
+}
+
+TEST(ConcurrentVectorTest, ElementsNeverMove) {
+  ConcurrentVector<int> v;
+  v.push_back(42);
+  const int *first = &v[0];
+  v.grow_by(100000);
+  ASSERT_EQ(&v[0], first);
+  ASSERT_EQ(*first, 42);
+}
+
+TEST(ConcurrentVectorTest, ReserveAndClear) {
+  ConcurrentVector<int> v;
+  v.reserve(100);
+  ASSERT_GE(v.capacity(), 100);
+  ASSERT_EQ(v.size(), 0);
+  v.grow_by(50, 1);
+  v.clear();
+  ASSERT_TRUE(v.empty());
+  ASSERT_EQ(v.capacity(), 0);
+  v.push_back(5);
+  ASSERT_EQ(v[0], 5);
+}
+
+TEST(ConcurrentVectorTest, ConcurrentPushBack) {
+  const int threads = 8;
+  const int per_thread = 20000;
+  ConcurrentVector<int> v;
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t)
+    pool.emplace_back([&v, t] {
+      for (int i = 0; i < per_thread; ++i) {
+        const int val = t * per_thread + i;
+        const std::size_t idx = v.push_back(val);
+        // Own elements are readable while others keep appending
+        ASSERT_EQ(v[idx], val);
+      }
+    });
+  for (auto &th : pool)
+    th.join();
+
+  ASSERT_EQ(v.size(), threads * per_thread);
+  std::vector<int> seen(v.begin(), v.end());
+  std::sort(seen.begin(), seen.end());
+  for (int i = 0; i < threads * per_thread; ++i)
+    ASSERT_EQ(seen[i], i);
+}
+
+TEST(ConcurrentVectorTest, ConcurrentGrowByAndRead) {
+  ConcurrentVector<int> v;
+  std::atomic<std::size_t> published(0);
+  std::atomic<bool> done(false);
+
+  // Writers append blocks of their block index; the reader only looks at
+  // blocks whose end was published through an atomic
+  std::vector<std::thread> pool;
+  for (int t = 0; t < 4; ++t)
+    pool.emplace_back([&] {
+      for (int i = 0; i < 500; ++i) {
+        const std::size_t first = v.grow_by(37);
+        for (std::size_t j = first; j < first + 37; ++j)
+          v[j] = static_cast<int>(first);
+        std::size_t cur = published.load();
+        while (cur < first + 37 &&
+               !published.compare_exchange_weak(cur, first + 37))
+          ;
+      }
+    });
+  std::thread reader([&] {
+    while (!done.load()) {
+      const std::size_t n = published.load();
+      if (n > 0) {
+        ASSERT_LE(v[n - 1], static_cast<int>(n - 1));
+      }
+    }
+  });
+  for (auto &th : pool)
+    th.join();
+  done = true;
+  reader.join();
+
+  ASSERT_EQ(v.size(), 4 * 500 * 37);
+  for (std::size_t i = 0; i < v.size(); ++i)
+    ASSERT_EQ(v[v[i]], v[i]); // every block starts at its own index
+}
+
+// Indices past the installed segments are claimed before their segment
+// exists; reading one must throw rather than dereference a null segment
+TEST(ConcurrentVectorTest, IndexDuringAppend) {
+  ConcurrentVector<int> v;
+  std::atomic<bool> done(false);
+  std::vector<std::thread> pool;
+  for (int t = 0; t < 4; ++t)
+    pool.emplace_back([&] {
+      for (int i = 0; i < 20000; ++i)
+        v.grow_by(3);
+    });
+  std::size_t seen = 0;
+  std::thread reader([&] {
+    while (!done.load()) {
+      const std::size_t n = v.size();
+      for (std::size_t i = n > 64 ? n - 64 : 0; i < n; ++i) {
+        try {
+          // Only the address: the element may still be being written
+          if (&v[i] != nullptr)
+            ++seen;
+        } catch (const std::out_of_range &) {
+        }
+      }
+    }
+  });
+  for (auto &th : pool)
+    th.join();
+  done = true;
+  reader.join();
+
+  ASSERT_EQ(v.size(), 4 * 20000 * 3);
+  std::size_t n = 0;
+  for (auto it = v.begin(); it != v.end(); ++it)
+    ++n;
+  ASSERT_EQ(n, v.size());
+  ASSERT_LE(v.capacity(), 2 * v.size() + 8);
+}
+
+namespace {
+// Default construction, and so allocating a segment, fails while fail is set
+struct Fragile {
+  static std::atomic<bool> fail;
+  int x;
+  Fragile() : x(0) {
+    if (fail.load())
+      throw std::bad_alloc();
+  }
+  Fragile(int p_x) : x(p_x) {}
+};
+std::atomic<bool> Fragile::fail(false);
+} // namespace
+
+// A failed segment allocation must not wedge later appends into the same
+// segment
+TEST(ConcurrentVectorTest, AllocationFailure) {
+  ConcurrentVector<Fragile> v;
+  const Fragile one(1), two(2);
+  Fragile::fail = true;
+  ASSERT_THROW(v.push_back(one), std::bad_alloc);
+  Fragile::fail = false;
+  ASSERT_EQ(v.size(), 1);
+  ASSERT_THROW(v[0], std::out_of_range);
+
+  // Append from another thread, so a regression fails instead of hanging
+  std::atomic<bool> done(false);
+  std::size_t idx = 0;
+  std::thread([&] {
+    idx = v.push_back(two);
+    done = true;
+  }).detach();
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!done.load() && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::yield();
+  ASSERT_TRUE(done.load());
+  ASSERT_EQ(idx, 1);
+  ASSERT_EQ(v[1].x, 2);
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "tlib/deque.h"
+
+TEST(DequeTest, DefaultConstructor) {
+  tlib::Deque<int> d;
+  ASSERT_TRUE(d.empty());
+  ASSERT_EQ(d.size(), 0);
+  ASSERT_EQ(d.begin(), d.end());
+}
+
+TEST(DequeTest, SizeConstructor) {
+  tlib::Deque<int> d(1000);
+  ASSERT_EQ(d.size(), 1000);
+  tlib::Deque<int> d2(10, 123);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(d2[i], 123);
+  }
+}
+
+TEST(DequeTest, InitializerList) {
+  tlib::Deque<int> d{1, 2, 3, 4, 5};
+  ASSERT_EQ(d.size(), 5);
+  for (int i = 0; i < 5; i++) {
+    ASSERT_EQ(d[i], i + 1);
+  }
+  ASSERT_ANY_THROW(d[5]);
+}
+
+TEST(DequeTest, CopyMove) {
+  tlib::Deque<int> d{1, 2, 3};
+  tlib::Deque<int> d2(d);
+  ASSERT_EQ(d2.size(), 3);
+  ASSERT_EQ(d2[2], 3);
+  d2[0] = 10;
+  ASSERT_EQ(d[0], 1);
+
+  tlib::Deque<int> d3 = std::move(d2);
+  ASSERT_EQ(d2.size(), 0);
+  ASSERT_EQ(d3.size(), 3);
+  ASSERT_EQ(d3[0], 10);
+}
+
+TEST(DequeTest, PushBothEnds) {
+  tlib::Deque<int> d;
+  for (int i = 0; i < 1000; i++) {
+    d.push_back(i);
+    d.push_front(-i - 1);
+  }
+  ASSERT_EQ(d.size(), 2000);
+  for (int i = 0; i < 2000; i++) {
+    ASSERT_EQ(d[i], i - 1000);
+  }
+  ASSERT_EQ(d.front(), -1000);
+  ASSERT_EQ(d.back(), 999);
+}
+
+TEST(DequeTest, Pop) {
+  tlib::Deque<int> d{1, 2, 3, 4, 5};
+  d.pop_front();
+  d.pop_back();
+  ASSERT_EQ(d.size(), 3);
+  ASSERT_EQ(d.front(), 2);
+  ASSERT_EQ(d.back(), 4);
+  d.clear();
+  ASSERT_TRUE(d.empty());
+  ASSERT_ANY_THROW(d.pop_front());
+  ASSERT_ANY_THROW(d.pop_back());
+  ASSERT_ANY_THROW(d.front());
+}
+
+TEST(DequeTest, Fifo) {
+  // A queue that keeps sliding forward reuses its blocks
+  tlib::Deque<int> d;
+  int next = 0;
+  for (int i = 0; i < 100000; i++) {
+    d.push_back(i);
+    if (i % 3 != 0) {
+      ASSERT_EQ(d.front(), next++);
+      d.pop_front();
+    }
+  }
+  ASSERT_EQ(d.size(), 100000 - next);
+  for (std::size_t i = 0; i < d.size(); i++) {
+    ASSERT_EQ(d[i], next + i);
+  }
+}
+
+TEST(DequeTest, Iterator) {
+  tlib::Deque<int> d;
+  for (int i = 0; i < 500; i++) {
+    d.push_front(i);
+  }
+  auto it = d.begin();
+  ASSERT_EQ(d.end() - it, 500);
+  ASSERT_EQ(*it, 499);
+  ASSERT_EQ(it[499], 0);
+  ASSERT_EQ(*(it + 200), 299);
+
+  std::sort(d.begin(), d.end());
+  int i = 0;
+  for (auto v : d) {
+    ASSERT_EQ(v, i++);
+  }
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <type_traits>
+
+#include "tlib/fixed_string.h"
+
+using tlib::FixedString;
+
+constexpr FixedString<16> kName("tlib");
+static_assert(kName.size() == 4, "");
+static_assert(kName[0] == 't', "");
+static_assert(kName == "tlib", "");
+static_assert(kName != "tli", "");
+static_assert(std::is_trivially_destructible<FixedString<8>>::value, "");
+
+constexpr auto kExact = tlib::make_fixed_string("hello");
+static_assert(kExact.capacity() == 5 && kExact.size() == 5, "");
+
+constexpr FixedString<32> make_greeting() {
+  FixedString<32> s("hello");
+  s.push_back(',');
+  s.push_back(' ');
+  s.append(kName);
+  return s;
+}
+static_assert(make_greeting() == "hello, tlib", "");
+
+TEST(FixedStringTest, Constructor) {
+  FixedString<8> s;
+  ASSERT_TRUE(s.empty());
+  ASSERT_EQ(s, "");
+  FixedString<8> s2("abc");
+  ASSERT_EQ(s2.size(), 3);
+  ASSERT_STREQ(s2.c_str(), "abc");
+  ASSERT_ANY_THROW(FixedString<2>("abc"));
+}
+
+TEST(FixedStringTest, Modifiers) {
+  FixedString<4> s("ab");
+  s.push_back('c');
+  s.append("d");
+  ASSERT_EQ(s, "abcd");
+  ASSERT_ANY_THROW(s.push_back('e'));
+  s[0] = 'x';
+  ASSERT_EQ(s, "xbcd");
+  ASSERT_ANY_THROW(s[4]);
+  s.clear();
+  ASSERT_EQ(s.size(), 0);
+  ASSERT_STREQ(s.c_str(), "");
+}
+
+TEST(FixedStringTest, SelfAppend) {
+  FixedString<16> s("ab");
+  s.append(s);
+  ASSERT_EQ(s, "abab");
+  s.append(s.c_str() + 1);
+  ASSERT_EQ(s, "ababbab");
+
+  // Too long: throws and leaves the string as it was
+  FixedString<5> t("abc");
+  ASSERT_THROW(t.append(t), std::length_error);
+  ASSERT_EQ(t, "abc");
+}
+
+TEST(FixedStringTest, Equality) {
+  FixedString<8> a("abc");
+  FixedString<16> b("abc");
+  FixedString<16> c("abcd");
+  ASSERT_TRUE(a == b);
+  ASSERT_TRUE(a != c);
+  ASSERT_TRUE(kExact == "hello");
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <type_traits>
+
+#include "tlib/fixed_vector.h"
+
+using tlib::FixedVector;
+
+// Table of squares built at compile time
+constexpr FixedVector<int, 16> make_squares() {
+  FixedVector<int, 16> v;
+  for (int i = 0; i < 16; i++)
+    v.push_back(i * i);
+  return v;
+}
+
+constexpr auto kSquares = make_squares();
+static_assert(kSquares.size() == 16, "");
+static_assert(kSquares[15] == 225, "");
+static_assert(kSquares.back() == 225, "");
+static_assert(std::is_trivially_destructible<FixedVector<int, 4>>::value, "");
+
+constexpr FixedVector<char, 4> kLetters{'a', 'b', 'c'};
+static_assert(kLetters.size() == 3 && kLetters[1] == 'b', "");
+
+TEST(FixedVectorTest, Constructor) {
+  FixedVector<int, 8> v;
+  ASSERT_TRUE(v.empty());
+  ASSERT_EQ(v.capacity(), 8);
+
+  FixedVector<int, 8> v2(5, 7);
+  ASSERT_EQ(v2.size(), 5);
+  ASSERT_EQ(v2[4], 7);
+  ASSERT_ANY_THROW((FixedVector<int, 2>(3, 0)));
+  ASSERT_ANY_THROW((FixedVector<int, 2>{1, 2, 3}));
+}
+
+TEST(FixedVectorTest, PushPop) {
+  FixedVector<int, 3> v;
+  v.push_back(1);
+  v.push_back(2);
+  v.push_back(3);
+  ASSERT_TRUE(v.full());
+  ASSERT_ANY_THROW(v.push_back(4));
+  v.pop_back();
+  ASSERT_EQ(v.size(), 2);
+  ASSERT_EQ(v.back(), 2);
+  ASSERT_ANY_THROW(v[2]);
+  v.clear();
+  ASSERT_ANY_THROW(v.pop_back());
+  ASSERT_ANY_THROW(v.front());
+}
+
+TEST(FixedVectorTest, Iterator) {
+  int i = 0;
+  for (auto v : kSquares) {
+    ASSERT_EQ(v, i * i);
+    i++;
+  }
+  ASSERT_EQ(i, 16);
+  ASSERT_EQ(kSquares.end() - kSquares.begin(), 16);
+}
+
+TEST(FixedVectorTest, Resize) {
+  FixedVector<int, 10> v{1, 2};
+  v.resize(5);
+  ASSERT_EQ(v.size(), 5);
+  ASSERT_EQ(v[4], 0);
+  ASSERT_ANY_THROW(v.resize(11));
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+
+#include "tlib/flat_map.h"
+
+TEST(FlatMapTest, DefaultConstructor) {
+  tlib::FlatMap<int, int> m;
+  ASSERT_TRUE(m.empty());
+  ASSERT_EQ(m.size(), 0);
+  ASSERT_EQ(m.find(1), nullptr);
+}
+
+TEST(FlatMapTest, BulkBuild) {
+  tlib::FlatMap<int, char> m{{5, 'e'}, {1, 'a'}, {3, 'c'}, {1, 'x'}, {2, 'b'}};
+  ASSERT_EQ(m.size(), 4);
+  ASSERT_EQ(m.at(1), 'a'); // first occurrence wins
+  ASSERT_EQ(m.at(2), 'b');
+  ASSERT_EQ(m.at(5), 'e');
+  ASSERT_ANY_THROW(m.at(4));
+  for (std::size_t i = 1; i < m.size(); i++) {
+    ASSERT_LT(m.keys()[i - 1], m.keys()[i]);
+  }
+}
+
+TEST(FlatMapTest, InsertErase) {
+  tlib::FlatMap<int, int> m;
+  for (int i = 99; i >= 0; i--) {
+    ASSERT_TRUE(m.insert(i * 2, i));
+  }
+  ASSERT_FALSE(m.insert(10, 0));
+  ASSERT_EQ(m.size(), 100);
+  ASSERT_EQ(*m.find(10), 5);
+  ASSERT_EQ(m.count(11), 0);
+
+  ASSERT_EQ(m.erase(10), 1);
+  ASSERT_EQ(m.erase(10), 0);
+  ASSERT_EQ(m.size(), 99);
+  ASSERT_FALSE(m.contains(10));
+  ASSERT_TRUE(m.contains(12));
+
+  m[11] = 7;
+  ASSERT_EQ(m.at(11), 7);
+  ASSERT_EQ(m[13], 0);
+  ASSERT_EQ(m.size(), 101);
+}
+
+TEST(FlatMapTest, LowerBound) {
+  tlib::FlatMap<int, int> m{{10, 0}, {20, 1}, {30, 2}};
+  ASSERT_EQ(m.lower_bound(5), 0);
+  ASSERT_EQ(m.lower_bound(10), 0);
+  ASSERT_EQ(m.lower_bound(11), 1);
+  ASSERT_EQ(m.lower_bound(30), 2);
+  ASSERT_EQ(m.lower_bound(31), 3);
+}
+
+TEST(FlatMapTest, EytzingerIndex) {
+  std::mt19937 rng(42);
+  std::map<int, int> ref;
+  tlib::Vector<std::pair<int, int>> input(0);
+  for (int i = 0; i < 5000; i++) {
+    int k = rng() % 20000;
+    input.push_back({k, i});
+    ref.insert({k, i});
+  }
+  tlib::FlatMap<int, int> m(input.data(), input.data() + input.size());
+  ASSERT_EQ(m.size(), ref.size());
+
+  m.build_index();
+  ASSERT_TRUE(m.has_index());
+  for (int k = -1; k <= 20001; k++) {
+    auto it = ref.lower_bound(k);
+    auto expected = std::distance(ref.begin(), it);
+    ASSERT_EQ(m.lower_bound(k), expected);
+    const int *v = m.find(k);
+    if (it != ref.end() && it->first == k) {
+      ASSERT_NE(v, nullptr);
+      ASSERT_EQ(*v, it->second);
+    } else {
+      ASSERT_EQ(v, nullptr);
+    }
+  }
+
+  // Modifying the map drops the index
+  m.insert(-5, 0);
+  ASSERT_FALSE(m.has_index());
+  ASSERT_EQ(m.lower_bound(-5), 0);
+}
+
+TEST(FlatMapTest, EytzingerSmall) {
+  for (int n = 0; n < 20; n++) {
+    tlib::FlatMap<int, int> m;
+    for (int i = 0; i < n; i++) {
+      m.insert(i * 2, i);
+    }
+    m.build_index();
+    for (int k = -1; k <= 2 * n; k++) {
+      ASSERT_EQ(m.lower_bound(k), k < 0 ? 0 : (k + 1) / 2);
+    }
+  }
+}
@@ -0,0 +1,133 @@
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tlib/hash.h"
+#include "tlib/lru_cache.h"
+
+using tlib::Hash;
+using tlib::hash_bytes;
+using tlib::hash_int;
+
+TEST(HashTest, ReferenceVectors) {
+  // Published wyhash test vectors, seeded with their index
+  const char *msgs[] = {"", "a", "abc", "message digest",
+                        "abcdefghijklmnopqrstuvwxyz"};
+  const std::uint64_t expected[] = {
+      0x93228a4de0eec5a2ull, 0xc5bac3db178713c4ull, 0xa97f2f7b1d9b3314ull,
+      0x786d1f1df3801df4ull, 0xdca5a8138ad37c87ull};
+  for (int i = 0; i < 5; ++i)
+    ASSERT_EQ(hash_bytes(msgs[i], std::strlen(msgs[i]), i), expected[i]);
+}
+
+TEST(HashTest, Bytes) {
+  const char buf[] = "hello world, this is a somewhat longer input "
+                     "that crosses the 48 byte rounds of the hasher";
+  for (std::size_t n = 0; n < sizeof(buf); ++n) {
+    ASSERT_EQ(hash_bytes(buf, n), hash_bytes(std::string(buf, n).data(), n));
+    if (n > 0) {
+      ASSERT_NE(hash_bytes(buf, n), hash_bytes(buf, n - 1));
+    }
+  }
+  // Trailing zero bytes and the seed both change the hash
+  const char zeros[4] = {};
+  ASSERT_NE(hash_bytes(zeros, 1), hash_bytes(zeros, 2));
+  ASSERT_NE(hash_bytes(buf, 10, 1), hash_bytes(buf, 10, 2));
+}
+
+TEST(HashTest, Functors) {
+  ASSERT_EQ(Hash<int>()(42), hash_int(42));
+  ASSERT_NE(Hash<int>()(1), 1);
+  ASSERT_EQ(Hash<double>()(0.0), Hash<double>()(-0.0));
+  ASSERT_NE(Hash<double>()(1.0), Hash<double>()(2.0));
+
+  int x = 0;
+  ASSERT_EQ(Hash<int *>()(&x), Hash<int *>()(&x));
+
+  enum class Color { Red, Green };
+  ASSERT_NE(Hash<Color>()(Color::Red), Hash<Color>()(Color::Green));
+
+  tlib::String s("tlib");
+  ASSERT_EQ(Hash<tlib::String>()(s), Hash<std::string>()("tlib"));
+  ASSERT_EQ(Hash<tlib::String>()(s), hash_bytes("tlib", 4));
+}
+
+// Flipping any input bit flips each output bit with probability close to
+// one half
+template <typename F> void check_avalanche(std::size_t p_bytes, F p_hash) {
+  const int samples = 2000;
+  std::mt19937_64 rng(3);
+  std::vector<int> flips(p_bytes * 8 * 64, 0);
+  std::vector<unsigned char> in(p_bytes);
+  for (int s = 0; s < samples; ++s) {
+    for (auto &c : in)
+      c = static_cast<unsigned char>(rng());
+    const std::uint64_t base = p_hash(in.data());
+    for (std::size_t bit = 0; bit < p_bytes * 8; ++bit) {
+      in[bit / 8] ^= 1 << (bit % 8);
+      const std::uint64_t diff = base ^ p_hash(in.data());
+      in[bit / 8] ^= 1 << (bit % 8);
+      for (int out = 0; out < 64; ++out)
+        flips[bit * 64 + out] += (diff >> out) & 1;
+    }
+  }
+  for (int f : flips) {
+    ASSERT_GT(f, samples * 0.4);
+    ASSERT_LT(f, samples * 0.6);
+  }
+}
+
+TEST(HashTest, AvalancheInt) {
+  check_avalanche(8, [](const unsigned char *p_in) {
+    std::uint64_t x;
+    std::memcpy(&x, p_in, 8);
+    return hash_int(x);
+  });
+}
+
+TEST(HashTest, AvalancheBytes) {
+  for (std::size_t n : {3, 8, 16, 24, 64})
+    check_avalanche(n, [n](const unsigned char *p_in) {
+      return hash_bytes(p_in, n);
+    });
+}
+
+// Keys that are all alike in the low bits still fill a power-of-two table
+// evenly
+template <typename F> void check_buckets(F p_key_hash) {
+  const std::size_t buckets = 1024;
+  const std::size_t keys = 64 * buckets;
+  std::vector<std::size_t> load(buckets, 0);
+  for (std::size_t i = 0; i < keys; ++i)
+    ++load[p_key_hash(i) & (buckets - 1)];
+  // Chi-squared against a uniform distribution; 1023 degrees of freedom
+  // have mean 1023 and standard deviation about 45
+  const double expected = double(keys) / buckets;
+  double chi2 = 0;
+  for (std::size_t l : load)
+    chi2 += (l - expected) * (l - expected) / expected;
+  ASSERT_LT(chi2, 1023 + 6 * 45);
+}
+
+TEST(HashTest, BucketDistribution) {
+  // Multiples of the table size all land in bucket 0 with std::hash
+  check_buckets([](std::size_t p_i) { return Hash<std::size_t>()(p_i << 10); });
+  check_buckets([](std::size_t p_i) { return Hash<std::size_t>()(p_i); });
+  check_buckets([](std::size_t p_i) {
+    return Hash<std::string>()("key" + std::to_string(p_i));
+  });
+  check_buckets([](std::size_t p_i) {
+    return Hash<double>()(static_cast<double>(p_i));
+  });
+}
+
+TEST(HashTest, AsHashParameter) {
+  tlib::LruCache<std::string, int, Hash<std::string>> c(2);
+  c.put("a", 1);
+  c.put("b", 2);
+  ASSERT_EQ(*c.get("a"), 1);
+  c.put("c", 3);
+  ASSERT_FALSE(c.contains("b"));
+}
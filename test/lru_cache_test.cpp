@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tlib/lru_cache.h"
+
+using tlib::LruCache;
+
+TEST(LruCacheTest, Constructor) {
+  LruCache<int, int> c(3);
+  ASSERT_TRUE(c.empty());
+  ASSERT_EQ(c.size(), 0);
+  ASSERT_EQ(c.capacity(), 3);
+  ASSERT_EQ(c.get(1), nullptr);
+  ASSERT_ANY_THROW((LruCache<int, int>(0)));
+}
+
+TEST(LruCacheTest, PutGet) {
+  LruCache<int, int> c(3);
+  c.put(1, 10);
+  c.put(2, 20);
+  ASSERT_EQ(c.size(), 2);
+  ASSERT_EQ(*c.get(1), 10);
+  ASSERT_EQ(*c.get(2), 20);
+
+  c.put(1, 11);
+  ASSERT_EQ(c.size(), 2);
+  ASSERT_EQ(*c.get(1), 11);
+
+  *c.get(2) = 21;
+  ASSERT_EQ(*c.peek(2), 21);
+  ASSERT_TRUE(c.contains(2));
+  ASSERT_FALSE(c.contains(3));
+}
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed) {
+  LruCache<int, int> c(3);
+  c.put(1, 1);
+  c.put(2, 2);
+  c.put(3, 3);
+  c.get(1); // 2 is now the oldest
+  c.put(4, 4);
+  ASSERT_EQ(c.size(), 3);
+  ASSERT_FALSE(c.contains(2));
+  ASSERT_TRUE(c.contains(1));
+  ASSERT_EQ(c.evictions(), 1);
+
+  // peek() does not refresh recency
+  c.peek(3);
+  c.put(5, 5);
+  ASSERT_FALSE(c.contains(3));
+
+  std::vector<int> order;
+  c.for_each([&](int p_k, int) { order.push_back(p_k); });
+  ASSERT_EQ(order, (std::vector<int>{5, 4, 1}));
+}
+
+TEST(LruCacheTest, Erase) {
+  LruCache<int, int> c(4);
+  for (int i = 0; i < 4; ++i)
+    c.put(i, i);
+  ASSERT_TRUE(c.erase(1));
+  ASSERT_FALSE(c.erase(1));
+  ASSERT_EQ(c.size(), 3);
+  ASSERT_FALSE(c.contains(1));
+  for (int i : {0, 2, 3})
+    ASSERT_EQ(*c.peek(i), i);
+
+  // Freed nodes are reused
+  c.put(7, 7);
+  c.put(8, 8);
+  ASSERT_EQ(c.size(), 4);
+  ASSERT_FALSE(c.contains(0));
+
+  c.clear();
+  ASSERT_TRUE(c.empty());
+  ASSERT_EQ(c.weight(), 0);
+  c.put(9, 9);
+  ASSERT_EQ(*c.get(9), 9);
+}
+
+TEST(LruCacheTest, EvictionCallback) {
+  LruCache<int, int> c(2);
+  std::vector<int> evicted;
+  c.set_eviction_callback(
+      [&](const int &p_k, const int &) { evicted.push_back(p_k); });
+  c.put(1, 1);
+  c.put(2, 2);
+  c.put(3, 3);
+  c.erase(2); // not an eviction
+  c.put(4, 4);
+  c.put(5, 5);
+  ASSERT_EQ(evicted, (std::vector<int>{1, 3}));
+}
+
+TEST(LruCacheTest, Weight) {
+  LruCache<int, std::string> c(10, [](const int &, const std::string &p_v) {
+    return p_v.size();
+  });
+  c.put(1, "aaaa");
+  c.put(2, "bbbb");
+  ASSERT_EQ(c.weight(), 8);
+  c.put(3, "cccc");
+  ASSERT_EQ(c.weight(), 8);
+  ASSERT_FALSE(c.contains(1));
+
+  // Growing an entry in place can evict others
+  c.put(3, "cccccccc");
+  ASSERT_EQ(c.size(), 1);
+  ASSERT_EQ(c.weight(), 8);
+
+  // An entry heavier than the capacity is kept on its own
+  c.put(4, "dddddddddddd");
+  ASSERT_EQ(c.size(), 1);
+  ASSERT_TRUE(c.contains(4));
+}
+
+TEST(LruCacheTest, Stats) {
+  LruCache<int, int> c(2);
+  c.put(1, 1);
+  c.get(1);
+  c.get(2);
+  c.get(1);
+  c.peek(2);
+  ASSERT_EQ(c.hits(), 2);
+  ASSERT_EQ(c.misses(), 1);
+  c.reset_stats();
+  ASSERT_EQ(c.hits(), 0);
+  ASSERT_EQ(c.misses(), 0);
+}
+
+TEST(LruCacheTest, StringKeys) {
+  LruCache<std::string, std::string> c(100);
+  for (int i = 0; i < 300; ++i)
+    c.put("key" + std::to_string(i), "v");
+  ASSERT_EQ(c.size(), 100);
+  ASSERT_FALSE(c.contains("key199"));
+  ASSERT_TRUE(c.contains("key200"));
+  ASSERT_TRUE(c.contains("key299"));
+}
+
+// Random puts and erases checked against a model, to exercise rehashing and
+// deletion in the hash index
+TEST(LruCacheTest, MatchesModel) {
+  const std::size_t cap = 64;
+  LruCache<int, int> c(cap);
+  std::vector<std::pair<int, int>> model; // most recent first
+  std::mt19937 rng(1);
+  for (int step = 0; step < 20000; ++step) {
+    const int k = rng() % 200;
+    auto it = model.begin();
+    while (it != model.end() && it->first != k)
+      ++it;
+    switch (rng() % 3) {
+    case 0: {
+      if (it != model.end())
+        model.erase(it);
+      model.insert(model.begin(), {k, step});
+      if (model.size() > cap)
+        model.pop_back();
+      c.put(k, step);
+      break;
+    }
+    case 1: {
+      int *v = c.get(k);
+      if (it == model.end()) {
+        ASSERT_EQ(v, nullptr);
+      } else {
+        ASSERT_NE(v, nullptr);
+        ASSERT_EQ(*v, it->second);
+        auto e = *it;
+        model.erase(it);
+        model.insert(model.begin(), e);
+      }
+      break;
+    }
+    case 2:
+      ASSERT_EQ(c.erase(k), it != model.end());
+      if (it != model.end())
+        model.erase(it);
+      break;
+    }
+    ASSERT_EQ(c.size(), model.size());
+  }
+  std::vector<std::pair<int, int>> order;
+  c.for_each([&](int p_k, int p_v) { order.emplace_back(p_k, p_v); });
+  ASSERT_EQ(order, model);
+}
+
+// Under Zipfian access a cache holding 10% of the keys serves most requests
+TEST(LruCacheTest, ZipfianHitRatio) {
+  const int keys = 10000;
+  std::vector<double> cdf(keys);
+  double sum = 0;
+  for (int i = 0; i < keys; ++i) {
+    sum += 1.0 / std::pow(i + 1, 0.99);
+    cdf[i] = sum;
+  }
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> uni(0, sum);
+
+  LruCache<int, int> c(keys / 10);
+  for (int i = 0; i < 200000; ++i) {
+    const int k = std::lower_bound(cdf.begin(), cdf.end(), uni(rng)) -
+                  cdf.begin();
+    if (!c.get(k))
+      c.put(k, k);
+  }
+  const double ratio = double(c.hits()) / (c.hits() + c.misses());
+  ASSERT_GT(ratio, 0.6);
+  ASSERT_EQ(c.hits() + c.misses(), 200000);
+}
@@ -0,0 +1,136 @@
+#include <cstdio>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tlib/mapped_vector.h"
+
+class MappedVectorTestFixture : public ::testing::Test {
+protected:
+  void SetUp() override {
+    char tmpl[] = "/tmp/tlib_mapped_XXXXXX";
+    int fd = mkstemp(tmpl);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    path_ = tmpl;
+  }
+
+  void TearDown() override { unlink(path_.c_str()); }
+
+  std::string path_;
+};
+
+struct Point {
+  double x;
+  double y;
+};
+
+TEST_F(MappedVectorTestFixture, EmptyFile) {
+  tlib::MappedVector<int> v(path_.c_str());
+  ASSERT_TRUE(v.empty());
+  ASSERT_EQ(v.capacity(), 0);
+  ASSERT_EQ(v.begin(), v.end());
+  ASSERT_ANY_THROW(v.front());
+  ASSERT_ANY_THROW(v.pop_back());
+}
+
+TEST_F(MappedVectorTestFixture, PushBack) {
+  tlib::MappedVector<int> v(path_.c_str());
+  for (int i = 0; i < 100000; i++) {
+    v.push_back(i);
+  }
+  ASSERT_EQ(v.size(), 100000);
+  ASSERT_GE(v.capacity(), 100000);
+  for (int i = 0; i < 100000; i++) {
+    ASSERT_EQ(v[i], i);
+  }
+  ASSERT_EQ(v.front(), 0);
+  ASSERT_EQ(v.back(), 99999);
+  ASSERT_ANY_THROW(v[100000]);
+
+  v.pop_back();
+  ASSERT_EQ(v.back(), 99998);
+}
+
+TEST_F(MappedVectorTestFixture, PushBackOwnElement) {
+  tlib::MappedVector<int> v(path_.c_str());
+  v.push_back(7);
+  while (v.size() < v.capacity())
+    v.push_back(1);
+  // The argument lives in the mapping that the push remaps
+  v.push_back(v[0]);
+  ASSERT_EQ(v.back(), 7);
+  ASSERT_EQ(v[0], 7);
+}
+
+TEST_F(MappedVectorTestFixture, Reopen) {
+  {
+    tlib::MappedVector<Point> v(path_.c_str());
+    for (int i = 0; i < 1000; i++) {
+      v.push_back({i * 1.0, i * 2.0});
+    }
+    v.flush();
+  }
+  tlib::MappedVector<Point> v(path_.c_str());
+  ASSERT_EQ(v.size(), 1000);
+  ASSERT_EQ(v.capacity(), 1000);
+  ASSERT_EQ(v[999].x, 999.0);
+  ASSERT_EQ(v[999].y, 1998.0);
+}
+
+TEST_F(MappedVectorTestFixture, ResizeShrink) {
+  tlib::MappedVector<long> v(path_.c_str());
+  v.resize(10);
+  ASSERT_EQ(v.size(), 10);
+  for (auto x : v) {
+    ASSERT_EQ(x, 0);
+  }
+  v.reserve(5000);
+  ASSERT_EQ(v.capacity(), 5000);
+  v.shrink_to_fit();
+  ASSERT_EQ(v.capacity(), 10);
+  ASSERT_EQ(v.size(), 10);
+}
+
+TEST_F(MappedVectorTestFixture, AdviseAndIterate) {
+  tlib::MappedVector<int> v(path_.c_str());
+  for (int i = 0; i < 5000; i++) {
+    v.push_back(i);
+  }
+  v.advise(tlib::MappedVector<int>::Advice::Sequential);
+  long sum = 0;
+  for (auto x : v) {
+    sum += x;
+  }
+  ASSERT_EQ(sum, 5000L * 4999 / 2);
+  v.advise(tlib::MappedVector<int>::Advice::Random);
+  v.advise(tlib::MappedVector<int>::Advice::WillNeed);
+}
+
+TEST_F(MappedVectorTestFixture, Move) {
+  tlib::MappedVector<int> v(path_.c_str());
+  v.push_back(1);
+  tlib::MappedVector<int> v2 = std::move(v);
+  ASSERT_EQ(v.size(), 0);
+  ASSERT_EQ(v2.size(), 1);
+  ASSERT_EQ(v2[0], 1);
+}
+
+// A trailing partial element is not truncated away
+TEST_F(MappedVectorTestFixture, PartialElement) {
+  FILE *f = std::fopen(path_.c_str(), "wb");
+  ASSERT_NE(f, nullptr);
+  std::fwrite("1234567", 1, 7, f);
+  std::fclose(f);
+  ASSERT_THROW(tlib::MappedVector<int> v(path_.c_str()),
+               std::invalid_argument);
+  struct stat st;
+  ASSERT_EQ(stat(path_.c_str(), &st), 0);
+  ASSERT_EQ(st.st_size, 7);
+}
+
+TEST(MappedVectorTest, BadPath) {
+  ASSERT_ANY_THROW(tlib::MappedVector<int>("/nonexistent/dir/file"));
+}
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <functional>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tlib/priority_queue.h"
+
+using tlib::IndexedPriorityQueue;
+using tlib::PriorityQueue;
+
+TEST(PriorityQueueTest, Constructor) {
+  PriorityQueue<int> q;
+  ASSERT_TRUE(q.empty());
+  ASSERT_EQ(q.size(), 0);
+  ASSERT_ANY_THROW(q.top());
+  ASSERT_ANY_THROW(q.pop());
+  ASSERT_EQ(q.arity, 4);
+
+  PriorityQueue<int> q2{3, 1, 4, 1, 5};
+  ASSERT_EQ(q2.size(), 5);
+  ASSERT_EQ(q2.top(), 5);
+}
+
+TEST(PriorityQueueTest, PushPop) {
+  PriorityQueue<int> q;
+  for (int x : {5, 1, 8, 3, 9, 2})
+    q.push(x);
+  ASSERT_EQ(q.top(), 9);
+  std::vector<int> out;
+  while (!q.empty()) {
+    out.push_back(q.top());
+    q.pop();
+  }
+  ASSERT_EQ(out, (std::vector<int>{9, 8, 5, 3, 2, 1}));
+}
+
+TEST(PriorityQueueTest, MinHeap) {
+  PriorityQueue<std::string, std::greater<std::string>> q;
+  q.push("pear");
+  q.push("apple");
+  q.push("fig");
+  ASSERT_EQ(q.top(), "apple");
+  q.pop();
+  ASSERT_EQ(q.top(), "fig");
+}
+
+template <std::size_t D> void check_sorted_drain(std::size_t p_n) {
+  std::mt19937 rng(static_cast<unsigned>(p_n * D));
+  std::vector<int> ref(p_n);
+  for (auto &x : ref)
+    x = rng() % 1000;
+
+  // Bulk heapify and one-by-one pushes give the same order
+  tlib::Vector<int> vals(0);
+  for (int x : ref)
+    vals.push_back(x);
+  PriorityQueue<int, std::less<int>, D> bulk(vals);
+  PriorityQueue<int, std::less<int>, D> pushed;
+  for (int x : ref)
+    pushed.push(x);
+
+  std::sort(ref.begin(), ref.end(), std::greater<int>());
+  for (int x : ref) {
+    ASSERT_EQ(bulk.top(), x);
+    ASSERT_EQ(pushed.top(), x);
+    bulk.pop();
+    pushed.pop();
+  }
+  ASSERT_TRUE(bulk.empty());
+  ASSERT_TRUE(pushed.empty());
+}
+
+TEST(PriorityQueueTest, Arity) {
+  for (std::size_t n : {0, 1, 2, 5, 17, 1000}) {
+    check_sorted_drain<2>(n);
+    check_sorted_drain<3>(n);
+    check_sorted_drain<4>(n);
+    check_sorted_drain<8>(n);
+  }
+}
+
+TEST(PriorityQueueTest, Heapify) {
+  PriorityQueue<int> q{1, 2};
+  q.heapify(tlib::Vector<int>{7, 3, 9, 4});
+  ASSERT_EQ(q.size(), 4);
+  ASSERT_EQ(q.top(), 9);
+  q.clear();
+  ASSERT_TRUE(q.empty());
+  q.push(6);
+  ASSERT_EQ(q.top(), 6);
+}
+
+TEST(IndexedPriorityQueueTest, PushPop) {
+  IndexedPriorityQueue<int> q;
+  ASSERT_TRUE(q.empty());
+  ASSERT_ANY_THROW(q.top());
+  ASSERT_ANY_THROW(q.pop());
+
+  auto a = q.push(5);
+  auto b = q.push(9);
+  auto c = q.push(1);
+  ASSERT_EQ(q.size(), 3);
+  ASSERT_EQ(q.top(), 9);
+  ASSERT_EQ(q.top_handle(), b);
+  ASSERT_EQ(q.get(a), 5);
+  ASSERT_EQ(q.get(c), 1);
+
+  q.pop();
+  ASSERT_FALSE(q.contains(b));
+  ASSERT_ANY_THROW(q.get(b));
+  ASSERT_EQ(q.top_handle(), a);
+
+  // Freed handles are reused
+  ASSERT_EQ(q.push(3), b);
+}
+
+TEST(IndexedPriorityQueueTest, Promote) {
+  // Min-queue as used by Dijkstra, where promote() is decrease-key
+  IndexedPriorityQueue<int, std::greater<int>> q;
+  auto a = q.push(10);
+  auto b = q.push(20);
+  auto c = q.push(30);
+  q.promote(c, 5);
+  ASSERT_EQ(q.top_handle(), c);
+  q.promote(b, 5); // equal keys are allowed
+  ASSERT_EQ(q.get(b), 5);
+  ASSERT_THROW(q.promote(a, 11), std::invalid_argument);
+  ASSERT_EQ(q.get(a), 10);
+
+  // With the default max-queue it raises the key
+  IndexedPriorityQueue<int> m;
+  auto x = m.push(1);
+  m.push(2);
+  m.promote(x, 3);
+  ASSERT_EQ(m.top_handle(), x);
+  ASSERT_THROW(m.promote(x, 0), std::invalid_argument);
+}
+
+TEST(IndexedPriorityQueueTest, UpdateAndErase) {
+  IndexedPriorityQueue<int> q;
+  auto a = q.push(1);
+  auto b = q.push(2);
+  auto c = q.push(3);
+  q.update(c, 0);
+  ASSERT_EQ(q.top_handle(), b);
+  q.update(a, 7);
+  ASSERT_EQ(q.top_handle(), a);
+
+  q.erase(a);
+  ASSERT_FALSE(q.contains(a));
+  ASSERT_ANY_THROW(q.erase(a));
+  ASSERT_ANY_THROW(q.update(a, 1));
+  ASSERT_EQ(q.top_handle(), b);
+  ASSERT_EQ(q.size(), 2);
+
+  q.clear();
+  ASSERT_TRUE(q.empty());
+  ASSERT_FALSE(q.contains(b));
+}
+
+// Random operations checked against a sorted model
+TEST(IndexedPriorityQueueTest, MatchesModel) {
+  IndexedPriorityQueue<int, std::less<int>, 3> q;
+  std::vector<std::pair<std::size_t, int>> live; // handle, value
+  std::mt19937 rng(5);
+  for (int step = 0; step < 20000; ++step) {
+    const unsigned op = live.empty() ? 0 : rng() % 4;
+    const std::size_t pick = live.empty() ? 0 : rng() % live.size();
+    const int val = rng() % 10000;
+    switch (op) {
+    case 0:
+      live.emplace_back(q.push(val), val);
+      break;
+    case 1:
+      q.erase(live[pick].first);
+      live.erase(live.begin() + pick);
+      break;
+    case 2:
+      q.update(live[pick].first, val);
+      live[pick].second = val;
+      break;
+    case 3: {
+      int top = live[0].second;
+      for (const auto &e : live)
+        top = std::max(top, e.second);
+      ASSERT_EQ(q.top(), top);
+      const std::size_t h = q.top_handle();
+      q.pop();
+      live.erase(std::find_if(live.begin(), live.end(),
+                              [h](const std::pair<std::size_t, int> &x) {
+                                return x.first == h;
+                              }));
+      break;
+    }
+    }
+    ASSERT_EQ(q.size(), live.size());
+  }
+  for (const auto &e : live)
+    ASSERT_EQ(q.get(e.first), e.second);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "tlib/ring_buffer.h"
+
+TEST(RingBufferTest, Constructor) {
+  tlib::RingBuffer<int> rb(4);
+  ASSERT_TRUE(rb.empty());
+  ASSERT_FALSE(rb.full());
+  ASSERT_EQ(rb.capacity(), 4);
+}
+
+TEST(RingBufferTest, PushPop) {
+  tlib::RingBuffer<int> rb(4);
+  rb.push_back(1);
+  rb.push_back(2);
+  rb.push_front(0);
+  rb.push_back(3);
+  ASSERT_TRUE(rb.full());
+  ASSERT_ANY_THROW(rb.push_back(4));
+  ASSERT_ANY_THROW(rb.push_front(4));
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(rb[i], i);
+  }
+
+  rb.pop_front();
+  rb.pop_back();
+  ASSERT_EQ(rb.size(), 2);
+  ASSERT_EQ(rb.front(), 1);
+  ASSERT_EQ(rb.back(), 2);
+  rb.pop_front();
+  rb.pop_front();
+  ASSERT_ANY_THROW(rb.pop_front());
+  ASSERT_ANY_THROW(rb.back());
+}
+
+TEST(RingBufferTest, WrapAround) {
+  tlib::RingBuffer<int> rb(3);
+  for (int i = 0; i < 100; i++) {
+    rb.push_back(i);
+    if (rb.full())
+      rb.pop_front();
+  }
+  ASSERT_EQ(rb.size(), 2);
+  ASSERT_EQ(rb[0], 98);
+  ASSERT_EQ(rb[1], 99);
+
+  int expected = 98;
+  for (auto v : rb) {
+    ASSERT_EQ(v, expected++);
+  }
+}
+
+TEST(RingBufferTest, Copy) {
+  tlib::RingBuffer<int> rb(3);
+  rb.push_back(1);
+  rb.push_front(0);
+  tlib::RingBuffer<int> rb2(rb);
+  ASSERT_EQ(rb2.size(), 2);
+  ASSERT_EQ(rb2[0], 0);
+  ASSERT_EQ(rb2[1], 1);
+
+  tlib::RingBuffer<int> rb3 = std::move(rb2);
+  ASSERT_EQ(rb3.size(), 2);
+  ASSERT_EQ(rb2.size(), 0);
+}
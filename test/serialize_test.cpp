@@ -0,0 +1,175 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+
+#include "tlib/serialize.h"
+
+using tlib::BinaryReader;
+using tlib::BinaryWriter;
+using tlib::String;
+
+// Source reading from a buffer at most p_max bytes at a time
+static BinaryReader::Source chunked_source(const tlib::Vector<char> &p_buf,
+                                           std::size_t p_max) {
+  auto pos = std::make_shared<std::size_t>(0);
+  return [&p_buf, p_max, pos](char *p_dst, std::size_t p_n) {
+    std::size_t n = p_buf.size() - *pos;
+    n = n < p_n ? n : p_n;
+    n = n < p_max ? n : p_max;
+    std::memcpy(p_dst, p_buf.data() + *pos, n);
+    *pos += n;
+    return n;
+  };
+}
+
+TEST(SerializeTest, Scalars) {
+  tlib::Vector<char> buf(0);
+  {
+    BinaryWriter out(tlib::vector_sink(buf));
+    tlib::serialize(out, 42);
+    tlib::serialize(out, 2.5);
+    tlib::serialize(out, 'x');
+  }
+  ASSERT_EQ(buf.size(), sizeof(int) + sizeof(double) + 1);
+
+  BinaryReader in(buf.data(), buf.size());
+  int i;
+  double d;
+  char c;
+  tlib::deserialize(in, i);
+  tlib::deserialize(in, d);
+  tlib::deserialize(in, c);
+  ASSERT_EQ(i, 42);
+  ASSERT_EQ(d, 2.5);
+  ASSERT_EQ(c, 'x');
+  ASSERT_ANY_THROW(tlib::deserialize(in, c));
+}
+
+TEST(SerializeTest, Containers) {
+  tlib::Vector<char> buf(0);
+  tlib::Vector<std::uint32_t> v(0);
+  for (std::uint32_t i = 0; i < 10000; i++) {
+    v.push_back(i * 3);
+  }
+  tlib::List<int> l{1, 2, 3};
+  String s("hello world");
+  {
+    BinaryWriter out(tlib::vector_sink(buf), 64);
+    tlib::serialize(out, 'a'); // misalign the vector payload
+    tlib::serialize(out, v);
+    tlib::serialize(out, l);
+    tlib::serialize(out, s);
+    out.flush();
+  }
+
+  // Read back through a small chunk buffer and an uneven source
+  BinaryReader in(chunked_source(buf, 100), 32);
+  char a;
+  tlib::Vector<std::uint32_t> v2(0);
+  tlib::List<int> l2;
+  String s2("");
+  tlib::deserialize(in, a);
+  tlib::deserialize(in, v2);
+  tlib::deserialize(in, l2);
+  tlib::deserialize(in, s2);
+  ASSERT_EQ(a, 'a');
+  ASSERT_EQ(v2.size(), v.size());
+  for (std::size_t i = 0; i < v.size(); i++) {
+    ASSERT_EQ(v2[i], v[i]);
+  }
+  ASSERT_EQ(l2.size(), 3);
+  ASSERT_EQ(l2.at(2), 3);
+  ASSERT_EQ(s2, "hello world");
+  ASSERT_EQ(in.offset(), buf.size());
+}
+
+TEST(SerializeTest, NestedVector) {
+  tlib::Vector<tlib::Vector<int>> v(0);
+  v.resize(2);
+  v[0] = {1, 2};
+  v[1] = {3, 4, 5};
+  tlib::Vector<char> buf(0);
+  {
+    BinaryWriter out(tlib::vector_sink(buf));
+    tlib::serialize(out, v);
+  }
+  BinaryReader in(buf.data(), buf.size());
+  tlib::Vector<tlib::Vector<int>> v2(0);
+  tlib::deserialize(in, v2);
+  ASSERT_EQ(v2.size(), 2);
+  ASSERT_EQ(v2[1].size(), 3);
+  ASSERT_EQ(v2[1][2], 5);
+}
+
+TEST(SerializeTest, InPlaceViews) {
+  tlib::Vector<char> buf(0);
+  tlib::Vector<double> v{1.0, 2.0, 3.0};
+  {
+    BinaryWriter out(tlib::vector_sink(buf));
+    tlib::serialize(out, String("abc"));
+    tlib::serialize(out, v);
+  }
+
+  BinaryReader in(buf.data(), buf.size());
+  auto sv = tlib::view_string(in);
+  ASSERT_EQ(sv.size(), 3);
+  ASSERT_EQ(sv[0], 'a');
+  ASSERT_EQ(sv[2], 'c');
+  ASSERT_GE(sv.data(), buf.data());
+
+  auto dv = tlib::view_vector<double>(in);
+  ASSERT_EQ(dv.size(), 3);
+  ASSERT_EQ(dv[2], 3.0);
+  ASSERT_EQ(reinterpret_cast<const char *>(dv.data()) - buf.data(), 16 + 8);
+
+  // Views need the whole payload in memory. The failed view leaves the
+  // reader where it was.
+  BinaryReader streaming(chunked_source(buf, 8));
+  ASSERT_THROW(tlib::view_string(streaming), std::logic_error);
+  ASSERT_THROW(tlib::view_vector<double>(streaming), std::logic_error);
+  ASSERT_EQ(streaming.offset(), 0);
+  String s("");
+  tlib::deserialize(streaming, s);
+  ASSERT_EQ(s, "abc");
+}
+
+TEST(SerializeTest, CorruptLength) {
+  // A length prefix claiming far more than the payload
+  tlib::Vector<char> buf(0);
+  {
+    BinaryWriter out(tlib::vector_sink(buf));
+    out.write(std::uint64_t(1) << 60);
+    out.write_bytes("abcdefgh", 8);
+  }
+
+  {
+    BinaryReader in(buf.data(), buf.size());
+    String s("");
+    ASSERT_THROW(tlib::deserialize(in, s), std::runtime_error);
+  }
+  {
+    BinaryReader in(buf.data(), buf.size());
+    tlib::Vector<std::uint64_t> v(0);
+    ASSERT_THROW(tlib::deserialize(in, v), std::runtime_error);
+  }
+  {
+    BinaryReader in(buf.data(), buf.size());
+    tlib::Vector<tlib::Vector<int>> v(0);
+    ASSERT_THROW(tlib::deserialize(in, v), std::runtime_error);
+  }
+  {
+    BinaryReader in(buf.data(), buf.size());
+    ASSERT_THROW(tlib::view_vector<std::uint64_t>(in), std::runtime_error);
+  }
+
+  // Streaming readers run out of input after at most a chunk
+  {
+    BinaryReader in(chunked_source(buf, 8));
+    String s("");
+    ASSERT_THROW(tlib::deserialize(in, s), std::runtime_error);
+  }
+  {
+    BinaryReader in(chunked_source(buf, 8));
+    tlib::Vector<std::uint32_t> v(0);
+    ASSERT_THROW(tlib::deserialize(in, v), std::runtime_error);
+  }
+}
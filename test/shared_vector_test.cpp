@@ -0,0 +1,146 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "tlib/shared_vector.h"
+
+using tlib::AtomicSharedVector;
+using tlib::SharedVector;
+
+TEST(SharedVectorTest, Constructor) {
+  SharedVector<int> empty;
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(empty.use_count(), 0);
+  ASSERT_EQ(empty.begin(), empty.end());
+
+  SharedVector<int> v{1, 2, 3};
+  ASSERT_EQ(v.size(), 3);
+  ASSERT_EQ(v[2], 3);
+  ASSERT_EQ(v.front(), 1);
+  ASSERT_EQ(v.back(), 3);
+  ASSERT_ANY_THROW(v[3]);
+
+  tlib::Vector<int> src{4, 5};
+  SharedVector<int> v2(std::move(src));
+  ASSERT_EQ(v2.size(), 2);
+  ASSERT_EQ(v2[0], 4);
+}
+
+TEST(SharedVectorTest, CopiesShare) {
+  SharedVector<int> v{1, 2, 3};
+  SharedVector<int> v2 = v;
+  ASSERT_EQ(v.data(), v2.data());
+  ASSERT_EQ(v.use_count(), 2);
+  {
+    SharedVector<int> v3;
+    v3 = v2;
+    ASSERT_EQ(v.use_count(), 3);
+  }
+  ASSERT_EQ(v.use_count(), 2);
+
+  SharedVector<int> v4 = std::move(v2);
+  ASSERT_EQ(v.use_count(), 2);
+  ASSERT_EQ(v2.use_count(), 0);
+}
+
+TEST(SharedVectorTest, CopyOnWrite) {
+  SharedVector<int> v{1, 2, 3};
+  SharedVector<int> snapshot = v;
+
+  v.set(0, 10);
+  v.push_back(4);
+  ASSERT_NE(v.data(), snapshot.data());
+  ASSERT_EQ(v.use_count(), 1);
+  ASSERT_EQ(v[0], 10);
+  ASSERT_EQ(v.size(), 4);
+  ASSERT_EQ(snapshot[0], 1);
+  ASSERT_EQ(snapshot.size(), 3);
+
+  // Unshared snapshots are edited in place
+  const int *data = v.data();
+  v.set(1, 20);
+  ASSERT_EQ(v.data(), data);
+
+  SharedVector<int> fresh;
+  fresh.push_back(7);
+  ASSERT_EQ(fresh.size(), 1);
+  ASSERT_EQ(fresh[0], 7);
+}
+
+TEST(SharedVectorTest, PublishAcquire) {
+  AtomicSharedVector<int> table(SharedVector<int>{1, 1, 1});
+  auto snap = table.acquire();
+  ASSERT_EQ(snap.use_count(), 2);
+
+  auto prev = table.exchange(SharedVector<int>{2, 2});
+  ASSERT_EQ(prev.data(), snap.data());
+  ASSERT_EQ(table.acquire().size(), 2);
+  ASSERT_EQ(snap.size(), 3);
+}
+
+TEST(SharedVectorTest, ConcurrentReaders) {
+  // Every snapshot holds one version number in all slots; readers must
+  // never see a mix
+  const int kSlots = 64;
+  AtomicSharedVector<int> table(
+      SharedVector<int>(tlib::Vector<int>(kSlots, 0)));
+  std::atomic<bool> done(false);
+  std::atomic<int> bad(0);
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        SharedVector<int> snap = table.acquire();
+        for (auto x : snap) {
+          if (x != snap[0])
+            bad++;
+        }
+      }
+    });
+  }
+
+  SharedVector<int> next = table.acquire();
+  for (int version = 1; version <= 2000; version++) {
+    for (int i = 0; i < kSlots; i++)
+      next.set(i, version);
+    table.publish(next);
+  }
+  done = true;
+  for (auto &t : readers)
+    t.join();
+
+  ASSERT_EQ(bad.load(), 0);
+  ASSERT_EQ(table.acquire()[0], 2000);
+}
+
+TEST(SharedVectorTest, RepublishKeepsCountsBalanced) {
+  // Publishing the same two snapshots back and forth while readers
+  // acquire must leave exactly the writer's and the holder's references
+  SharedVector<int> a{1};
+  SharedVector<int> b{2};
+  AtomicSharedVector<int> table(a);
+  std::atomic<bool> done(false);
+  std::atomic<int> bad(0);
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        SharedVector<int> snap = table.acquire();
+        if (snap.size() != 1 || (snap[0] != 1 && snap[0] != 2))
+          bad++;
+      }
+    });
+  }
+  for (int i = 0; i < 20000; i++)
+    table.publish(i % 2 ? a : b);
+  done = true;
+  for (auto &t : readers)
+    t.join();
+
+  ASSERT_EQ(bad.load(), 0);
+  ASSERT_EQ(a.use_count(), 2); // a and the holder
+  ASSERT_EQ(b.use_count(), 1);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "tlib/soa_vector.h"
+
+using Records = tlib::SoAVector<int, double, char>;
+
+TEST(SoAVectorTest, DefaultConstructor) {
+  Records v;
+  ASSERT_TRUE(v.empty());
+  ASSERT_EQ(v.size(), 0);
+}
+
+TEST(SoAVectorTest, SizeConstructor) {
+  Records v(10);
+  ASSERT_EQ(v.size(), 10);
+  ASSERT_EQ(v.column<0>().size(), 10);
+  ASSERT_EQ(v.column<1>().size(), 10);
+  ASSERT_EQ(v.column<2>().size(), 10);
+}
+
+TEST(SoAVectorTest, PushBack) {
+  Records v;
+  for (int i = 0; i < 100; i++) {
+    v.push_back(i, i * 0.5, 'a' + i % 26);
+  }
+  v.push_back(std::make_tuple(100, 50.0, 'z'));
+  ASSERT_EQ(v.size(), 101);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(v.get<0>(i), i);
+    ASSERT_EQ(v.get<1>(i), i * 0.5);
+    ASSERT_EQ(v.get<2>(i), 'a' + i % 26);
+  }
+  ASSERT_EQ(v.back().get<0>(), 100);
+  ASSERT_EQ(v.back().get<2>(), 'z');
+
+  v.pop_back();
+  ASSERT_EQ(v.size(), 100);
+  ASSERT_EQ(v.column<1>().size(), 100);
+}
+
+TEST(SoAVectorTest, Columns) {
+  Records v;
+  for (int i = 0; i < 10; i++) {
+    v.push_back(i, i * 2.0, 'x');
+  }
+  // Columns are contiguous
+  const int *ints = v.data<0>();
+  const double *doubles = v.data<1>();
+  int isum = 0;
+  double dsum = 0;
+  for (std::size_t i = 0; i < v.size(); i++) {
+    isum += ints[i];
+    dsum += doubles[i];
+  }
+  ASSERT_EQ(isum, 45);
+  ASSERT_EQ(dsum, 90.0);
+  ASSERT_EQ(&v.column<0>()[3], ints + 3);
+}
+
+TEST(SoAVectorTest, RowProxy) {
+  Records v;
+  v.push_back(1, 1.5, 'a');
+  v.push_back(2, 2.5, 'b');
+
+  auto row = v[0];
+  row.get<0>() = 10;
+  ASSERT_EQ(v.get<0>(0), 10);
+
+  v[1] = std::make_tuple(20, 20.5, 'c');
+  ASSERT_EQ(v.get<0>(1), 20);
+  ASSERT_EQ(v.get<1>(1), 20.5);
+  ASSERT_EQ(v.get<2>(1), 'c');
+
+  v[0] = v[1];
+  std::tuple<int, double, char> t = v[0];
+  ASSERT_EQ(t, std::make_tuple(20, 20.5, 'c'));
+
+  ASSERT_ANY_THROW(v[2]);
+}
+
+TEST(SoAVectorTest, Iterator) {
+  Records v;
+  for (int i = 0; i < 5; i++) {
+    v.push_back(i, 0.0, 'a');
+  }
+  int i = 0;
+  for (auto row : v) {
+    ASSERT_EQ(row.get<0>(), i++);
+    row.get<1>() = 1.0;
+  }
+  ASSERT_EQ(i, 5);
+  for (int j = 0; j < 5; j++) {
+    ASSERT_EQ(v.get<1>(j), 1.0);
+  }
+
+  auto it = v.begin();
+  ASSERT_EQ(v.end() - it, 5);
+  ASSERT_EQ(it[3].get<0>(), 3);
+  ASSERT_EQ((*(it + 4)).get<0>(), 4);
+}
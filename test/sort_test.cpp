@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+
+#include "tlib/sort.h"
+
+template <typename T> static tlib::Vector<T> random_vector(std::size_t n) {
+  std::mt19937_64 rng(n);
+  tlib::Vector<T> v(0);
+  for (std::size_t i = 0; i < n; i++) {
+    v.push_back(static_cast<T>(rng()));
+  }
+  return v;
+}
+
+template <typename T> static void expect_sorted_like(tlib::Vector<T> v) {
+  tlib::Vector<T> expected = v;
+  std::sort(expected.data(), expected.data() + expected.size());
+  tlib::radix_sort(v);
+  ASSERT_EQ(v.size(), expected.size());
+  for (std::size_t i = 0; i < v.size(); i++) {
+    ASSERT_EQ(v[i], expected[i]);
+  }
+}
+
+TEST(SortTest, NetworkAllSizes) {
+  for (std::size_t n = 0; n <= 32; n++) {
+    auto v = random_vector<int>(n);
+    tlib::Vector<int> expected = v;
+    std::sort(expected.data(), expected.data() + n);
+    tlib::network_sort(v.data(), n);
+    for (std::size_t i = 0; i < n; i++) {
+      ASSERT_EQ(v[i], expected[i]);
+    }
+  }
+  int too_many[33] = {};
+  ASSERT_ANY_THROW(tlib::network_sort(too_many, 33));
+}
+
+TEST(SortTest, Unsigned) {
+  for (std::size_t n : {0, 1, 10, 33, 1000, 100000}) {
+    expect_sorted_like(random_vector<std::uint32_t>(n));
+    expect_sorted_like(random_vector<std::uint64_t>(n));
+  }
+}
+
+TEST(SortTest, Signed) {
+  expect_sorted_like(random_vector<std::int32_t>(5000));
+  expect_sorted_like(random_vector<std::int64_t>(5000));
+  expect_sorted_like(random_vector<std::int16_t>(5000));
+}
+
+TEST(SortTest, Float) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1e6f, 1e6f);
+  tlib::Vector<float> v(0);
+  for (int i = 0; i < 5000; i++) {
+    v.push_back(dist(rng));
+  }
+  v.push_back(0.0f);
+  v.push_back(-0.5f);
+  v.push_back(std::numeric_limits<float>::infinity());
+  v.push_back(-std::numeric_limits<float>::infinity());
+  expect_sorted_like(v);
+
+  tlib::Vector<double> small = {3.5, -1.0, 2.0, -7.25, 0.0};
+  expect_sorted_like(small);
+}
+
+// Small inputs go through the network, larger ones through radix passes;
+// both must keep every value, order -0.0 before 0.0 and put a positive NaN
+// last
+TEST(SortTest, FloatNanAndZeros) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  for (std::size_t n : {6, 32, 40}) {
+    tlib::Vector<float> v = {3.0f, nan, 1.0f, 2.0f, -0.0f, 0.0f};
+    while (v.size() < n)
+      v.push_back(5.0f);
+    tlib::radix_sort(v);
+    ASSERT_EQ(v.size(), n);
+    ASSERT_TRUE(std::signbit(v[0]) && v[0] == 0.0f);
+    ASSERT_TRUE(!std::signbit(v[1]) && v[1] == 0.0f);
+    ASSERT_EQ(v[2], 1.0f);
+    ASSERT_EQ(v[3], 2.0f);
+    ASSERT_EQ(v[4], 3.0f);
+    for (std::size_t i = 5; i < n - 1; i++)
+      ASSERT_EQ(v[i], 5.0f);
+    ASSERT_TRUE(std::isnan(v[n - 1]));
+  }
+
+  double d[] = {std::numeric_limits<double>::quiet_NaN(), 0.0, -0.0, -1.0};
+  tlib::network_sort(d, 4);
+  ASSERT_EQ(d[0], -1.0);
+  ASSERT_TRUE(std::signbit(d[1]));
+  ASSERT_FALSE(std::signbit(d[2]));
+  ASSERT_TRUE(std::isnan(d[3]));
+}
+
+TEST(SortTest, SmallRangeSkipsPasses) {
+  // Only the lowest byte differs
+  tlib::Vector<std::uint64_t> v(0);
+  for (int i = 0; i < 1000; i++) {
+    v.push_back(0xabcdef0000000000ull + (i * 37) % 256);
+  }
+  expect_sorted_like(v);
+}
+
+TEST(SortTest, ByKeyIsStable) {
+  struct Record {
+    int key;
+    int order;
+  };
+  for (int n : {20, 2000}) {
+    tlib::Vector<Record> v(0);
+    for (int i = 0; i < n; i++) {
+      v.push_back({(i * 7919) % 13 - 6, i});
+    }
+    tlib::Vector<Record> scratch(0);
+    tlib::radix_sort_by_key(v, scratch, [](const Record &r) { return r.key; });
+    for (int i = 1; i < n; i++) {
+      ASSERT_LE(v[i - 1].key, v[i].key);
+      if (v[i - 1].key == v[i].key) {
+        ASSERT_LT(v[i - 1].order, v[i].order);
+      }
+    }
+  }
+}
+
+TEST(SortTest, ByKeyNanAndZeros) {
+  struct Record {
+    double key;
+    int order;
+  };
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  for (std::size_t n : {3, 6, 32, 40}) {
+    tlib::Vector<Record> v = {{3.0, 0}, {nan, 1}, {1.0, 2}};
+    if (n > 3) {
+      v.push_back({0.0, 3});
+      v.push_back({-0.0, 4});
+      v.push_back({1.0, 5});
+    }
+    while (v.size() < n)
+      v.push_back({5.0, static_cast<int>(v.size())});
+    tlib::radix_sort_by_key(v, [](const Record &r) { return r.key; });
+    ASSERT_EQ(v.size(), n);
+    std::size_t i = 0;
+    if (n > 3) {
+      ASSERT_EQ(v[i++].order, 4); // -0.0
+      ASSERT_EQ(v[i++].order, 3); // 0.0
+    }
+    ASSERT_EQ(v[i++].order, 2);
+    if (n > 3) {
+      ASSERT_EQ(v[i++].order, 5); // stable after the other 1.0
+    }
+    ASSERT_EQ(v[i++].order, 0);
+    for (; i < n - 1; i++)
+      ASSERT_EQ(v[i].key, 5.0);
+    ASSERT_TRUE(std::isnan(v[n - 1].key));
+  }
+}
+
+TEST(SortTest, ScratchReuse) {
+  tlib::Vector<std::uint32_t> scratch(0);
+  for (std::size_t n : {100, 1000, 50}) {
+    auto v = random_vector<std::uint32_t>(n);
+    tlib::radix_sort(v, scratch);
+    ASSERT_TRUE(std::is_sorted(v.data(), v.data() + v.size()));
+  }
+  ASSERT_GE(scratch.capacity(), 1000);
+}
@@ -1,3 +1,6 @@
+#include <cstdint>
+#include <limits>
+#include <string>
 #include <gtest/gtest.h>
 
 #include "tlib/string.h"
@@ -44,3 +47,59 @@ TEST(StringOps, Subscript) {
   ASSERT_EQ(s1[3], 'd');
   ASSERT_ANY_THROW(s1[4]);
 }
+
+TEST(StringNumbers, AppendInt) {
+  String s("x=");
+  s.append_int(0);
+  s.append_int(-42);
+  s.append_int(1234567890123LL);
+  ASSERT_EQ(s, "x=0-421234567890123");
+
+  String s2("");
+  s2.append_int(std::numeric_limits<long long>::min());
+  ASSERT_EQ(s2, "-9223372036854775808");
+  String s3("");
+  s3.append_int(std::numeric_limits<unsigned long long>::max());
+  ASSERT_EQ(s3, "18446744073709551615");
+
+  String s4("x=");
+  s4.append_int(static_cast<signed char>(-1));
+  s4.append_int(static_cast<short>(-300));
+  s4.append_int(static_cast<std::int8_t>(INT8_MIN));
+  ASSERT_EQ(s4, "x=-1-300-128");
+
+  // Many appends reuse the spare capacity
+  String s5("");
+  std::string expected;
+  for (int i = 0; i < 10000; i++) {
+    s5.append_int(i);
+    expected += std::to_string(i);
+  }
+  ASSERT_EQ(s5, expected.c_str());
+  ASSERT_EQ(s5.size(), static_cast<int>(expected.size()));
+}
+
+TEST(StringNumbers, AppendFloat) {
+  String s("");
+  s.append_float(0.1);
+  ASSERT_EQ(s, "0.1");
+  String s2("v: ");
+  s2.append_float(0.1f);
+  ASSERT_EQ(s2, "v: 0.1");
+  String s3("");
+  s3.append_float(-1.5e300);
+  ASSERT_EQ(s3, "-1.5e+300");
+  String s4("");
+  s4.append_float(1);
+  ASSERT_EQ(s4, "1");
+}
+
+TEST(StringNumbers, Parse) {
+  ASSERT_EQ(String("12345").parse_int(), 12345);
+  ASSERT_EQ(String("-7").parse_int(), -7);
+  ASSERT_ANY_THROW(String("12a").parse_int());
+  ASSERT_ANY_THROW(String("99999999999999999999").parse_int());
+  ASSERT_EQ(String("2.5").parse_float(), 2.5);
+  ASSERT_EQ(String("-1e-3").parse_float(), -0.001);
+  ASSERT_ANY_THROW(String("abc").parse_float());
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <string>
 
 #include "tlib/vector.h"
 
@@ -134,3 +135,30 @@ TEST(VectorTest, PushBack) {
     ASSERT_EQ(v[i], i);
   }
 }
+
+TEST(VectorTest, PushBackOwnElement) {
+  tlib::Vector<std::string> v(0);
+  v.push_back("a long enough string to live on the heap");
+  for (int i = 0; i < 100; i++) {
+    v.push_back(v[0]); // reallocates whenever size() reaches capacity()
+  }
+  ASSERT_EQ(v.size(), 101);
+  for (std::size_t i = 0; i < v.size(); i++) {
+    ASSERT_EQ(v[i], v[0]);
+  }
+}
+
+TEST(VectorTest, Grow) {
+  tlib::Vector<int> v(0);
+  v.grow(3);
+  ASSERT_EQ(v.size(), 3);
+  ASSERT_EQ(v.capacity(), 3);
+  v.grow(4);
+  ASSERT_EQ(v.size(), 4);
+  ASSERT_EQ(v.capacity(), 6);
+  v.grow(20);
+  ASSERT_EQ(v.capacity(), 20);
+  v.grow(2);
+  ASSERT_EQ(v.size(), 2);
+  ASSERT_EQ(v.capacity(), 20);
+}
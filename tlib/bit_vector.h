@@ -0,0 +1,362 @@
+#ifndef TLIB_BIT_VECTOR_H
+#define TLIB_BIT_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "tlib/vector.h"
+
+// Words per rank superblock (512 bits)
+#define _RANK_BLOCK_WORDS 8
+
+namespace tlib {
+
+// Set bits in one word. Without a popcnt target (-mpopcnt, -march=...)
+// __builtin_popcountll is a libgcc call per word, so the branch-free
+// fallback is used instead.
+inline std::size_t popcount64(std::uint64_t p_x) noexcept {
+#if defined(__GNUC__) && defined(__POPCNT__)
+  return __builtin_popcountll(p_x);
+#else
+  p_x = p_x - ((p_x >> 1) & 0x5555555555555555ull);
+  p_x = (p_x & 0x3333333333333333ull) + ((p_x >> 2) & 0x3333333333333333ull);
+  p_x = (p_x + (p_x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+  return (p_x * 0x0101010101010101ull) >> 56;
+#endif
+}
+
+namespace bit_detail {
+
+inline std::size_t popcount_words_generic(const std::uint64_t *p_words,
+                                          std::size_t p_n) noexcept {
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < p_n; ++i)
+    n += popcount64(p_words[i]);
+  return n;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) &&      \
+    !defined(__POPCNT__)
+#define _BIT_POPCNT_DISPATCH
+
+// Compiled for popcnt regardless of the build flags; only called after the
+// CPU has been checked
+__attribute__((target("popcnt"))) inline std::size_t
+popcount_words_popcnt(const std::uint64_t *p_words, std::size_t p_n) noexcept {
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < p_n; ++i)
+    n += __builtin_popcountll(p_words[i]);
+  return n;
+}
+
+inline bool cpu_has_popcnt() noexcept {
+  static const bool has = (__builtin_cpu_init(),
+                           __builtin_cpu_supports("popcnt") != 0);
+  return has;
+}
+#endif
+
+} // namespace bit_detail
+
+// Set bits in p_n words. x86 builds that do not target popcnt check the CPU
+// once and use the instruction when it is there.
+inline std::size_t popcount_words(const std::uint64_t *p_words,
+                                  std::size_t p_n) noexcept {
+#if defined(_BIT_POPCNT_DISPATCH)
+  if (bit_detail::cpu_has_popcnt())
+    return bit_detail::popcount_words_popcnt(p_words, p_n);
+#endif
+  return bit_detail::popcount_words_generic(p_words, p_n);
+}
+
+// Index of the lowest set bit. p_x must not be zero.
+inline std::size_t ctz64(std::uint64_t p_x) noexcept {
+#if defined(__GNUC__)
+  return __builtin_ctzll(p_x);
+#else
+  std::size_t n = 0;
+  while (!(p_x & 1)) {
+    p_x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+// Packed bit array, one bit per element in 64-bit words. Counting and the
+// bitwise operators work a word at a time. build_rank_index() adds one
+// cumulative count per 512 bits so that rank() is O(1) and select() is a
+// binary search over those counts; any modification drops the index.
+class BitVector {
+private:
+  Vector<std::uint64_t> m_words;
+  std::size_t m_size;            // number of bits
+  Vector<std::uint64_t> m_ranks; // set bits before each superblock
+  bool m_has_index;
+
+  static std::size_t words_for(std::size_t p_bits) {
+    return (p_bits + 63) / 64;
+  }
+
+public:
+  enum : std::size_t { npos = static_cast<std::size_t>(-1) };
+
+  // Construct/copy/destroy
+  BitVector() : BitVector(0) {}
+
+  BitVector(std::size_t p_sz, bool p_val = false)
+      : m_words(words_for(p_sz), p_val ? ~std::uint64_t(0) : 0),
+        m_size(p_sz), m_ranks(0), m_has_index(false) {
+    trim();
+  }
+
+  // Capacity
+  inline bool empty() const noexcept { return m_size == 0; }
+
+  std::size_t size() const noexcept { return m_size; }
+
+  void resize(std::size_t p_sz, bool p_val = false) {
+    const std::size_t old_sz = m_size;
+    const std::size_t old_words = m_words.size();
+    const std::size_t new_words = words_for(p_sz);
+    m_words.grow(new_words);
+    for (std::size_t w = old_words; w < m_words.size(); ++w)
+      m_words.data()[w] = p_val ? ~std::uint64_t(0) : 0;
+    m_size = p_sz;
+    if (p_val && old_sz < p_sz && old_sz % 64)
+      m_words.data()[old_sz / 64] |= ~std::uint64_t(0) << (old_sz % 64);
+    trim();
+    m_has_index = false;
+  }
+
+  // Element access
+  bool test(std::size_t p_i) const {
+    if (p_i < m_size)
+      return (m_words.data()[p_i / 64] >> (p_i % 64)) & 1;
+    throw std::out_of_range("Out of range");
+  }
+  bool operator[](std::size_t p_i) const { return test(p_i); }
+
+  // Raw words; bits past size() in the last word are always zero
+  const std::uint64_t *data() const noexcept { return m_words.data(); }
+  std::size_t num_words() const noexcept { return m_words.size(); }
+
+  // Modifiers
+  void set(std::size_t p_i, bool p_val = true) {
+    if (p_i >= m_size)
+      throw std::out_of_range("Out of range");
+    const std::uint64_t mask = std::uint64_t(1) << (p_i % 64);
+    std::uint64_t &w = m_words.data()[p_i / 64];
+    w = p_val ? (w | mask) : (w & ~mask);
+    m_has_index = false;
+  }
+  void reset(std::size_t p_i) { set(p_i, false); }
+  void flip(std::size_t p_i) {
+    if (p_i >= m_size)
+      throw std::out_of_range("Out of range");
+    m_words.data()[p_i / 64] ^= std::uint64_t(1) << (p_i % 64);
+    m_has_index = false;
+  }
+
+  void set_all() {
+    for (std::size_t w = 0; w < m_words.size(); ++w)
+      m_words.data()[w] = ~std::uint64_t(0);
+    trim();
+    m_has_index = false;
+  }
+  void reset_all() {
+    for (std::size_t w = 0; w < m_words.size(); ++w)
+      m_words.data()[w] = 0;
+    m_has_index = false;
+  }
+  void flip_all() {
+    for (std::size_t w = 0; w < m_words.size(); ++w)
+      m_words.data()[w] = ~m_words.data()[w];
+    trim();
+    m_has_index = false;
+  }
+
+  void push_back(bool p_val) {
+    if (m_size % 64 == 0)
+      m_words.push_back(0);
+    if (p_val)
+      m_words.data()[m_size / 64] |= std::uint64_t(1) << (m_size % 64);
+    ++m_size;
+    m_has_index = false;
+  }
+
+  // Whole-vector bitwise operators. Both sides must have the same size.
+  BitVector &operator&=(const BitVector &p_other) {
+    check_size(p_other);
+    std::uint64_t *a = m_words.data();
+    const std::uint64_t *b = p_other.m_words.data();
+    for (std::size_t w = 0; w < m_words.size(); ++w)
+      a[w] &= b[w];
+    m_has_index = false;
+    return *this;
+  }
+  BitVector &operator|=(const BitVector &p_other) {
+    check_size(p_other);
+    std::uint64_t *a = m_words.data();
+    const std::uint64_t *b = p_other.m_words.data();
+    for (std::size_t w = 0; w < m_words.size(); ++w)
+      a[w] |= b[w];
+    m_has_index = false;
+    return *this;
+  }
+  BitVector &operator^=(const BitVector &p_other) {
+    check_size(p_other);
+    std::uint64_t *a = m_words.data();
+    const std::uint64_t *b = p_other.m_words.data();
+    for (std::size_t w = 0; w < m_words.size(); ++w)
+      a[w] ^= b[w];
+    m_has_index = false;
+    return *this;
+  }
+
+  friend BitVector operator&(BitVector p_lhs, const BitVector &p_rhs) {
+    return p_lhs &= p_rhs;
+  }
+  friend BitVector operator|(BitVector p_lhs, const BitVector &p_rhs) {
+    return p_lhs |= p_rhs;
+  }
+  friend BitVector operator^(BitVector p_lhs, const BitVector &p_rhs) {
+    return p_lhs ^= p_rhs;
+  }
+  BitVector operator~() const {
+    BitVector res = *this;
+    res.flip_all();
+    return res;
+  }
+
+  bool operator==(const BitVector &p_other) const {
+    if (m_size != p_other.m_size)
+      return false;
+    for (std::size_t w = 0; w < m_words.size(); ++w)
+      if (m_words.data()[w] != p_other.m_words.data()[w])
+        return false;
+    return true;
+  }
+  bool operator!=(const BitVector &p_other) const {
+    return !operator==(p_other);
+  }
+
+  // Queries
+  std::size_t count() const noexcept {
+    return popcount_words(m_words.data(), m_words.size());
+  }
+
+  bool any() const noexcept { return find_first() != npos; }
+  bool none() const noexcept { return !any(); }
+
+  // Position of the first set bit, or npos
+  std::size_t find_first() const noexcept { return find_from(0); }
+
+  // Position of the first set bit after p_pos, or npos
+  std::size_t find_next(std::size_t p_pos) const noexcept {
+    return p_pos + 1 >= m_size ? npos : find_from(p_pos + 1);
+  }
+
+  // Rank/select index
+  void build_rank_index() {
+    const std::size_t blocks =
+        (m_words.size() + _RANK_BLOCK_WORDS - 1) / _RANK_BLOCK_WORDS;
+    m_ranks.resize(blocks + 1);
+    std::uint64_t n = 0;
+    for (std::size_t b = 0; b < blocks; ++b) {
+      m_ranks.data()[b] = n;
+      const std::size_t end = (b + 1) * _RANK_BLOCK_WORDS < m_words.size()
+                                  ? (b + 1) * _RANK_BLOCK_WORDS
+                                  : m_words.size();
+      n += popcount_words(m_words.data() + b * _RANK_BLOCK_WORDS,
+                          end - b * _RANK_BLOCK_WORDS);
+    }
+    m_ranks.data()[blocks] = n;
+    m_has_index = true;
+  }
+
+  bool has_rank_index() const noexcept { return m_has_index; }
+
+  // Number of set bits in [0, p_pos). Without an index this counts from the
+  // start.
+  std::size_t rank(std::size_t p_pos) const {
+    if (p_pos > m_size)
+      throw std::out_of_range("Out of range");
+    const std::size_t word = p_pos / 64;
+    std::size_t n = 0;
+    std::size_t w = 0;
+    if (m_has_index) {
+      n = m_ranks.data()[word / _RANK_BLOCK_WORDS];
+      w = word / _RANK_BLOCK_WORDS * _RANK_BLOCK_WORDS;
+    }
+    n += popcount_words(m_words.data() + w, word - w);
+    if (p_pos % 64)
+      n += popcount64(m_words.data()[word] &
+                      ~(~std::uint64_t(0) << (p_pos % 64)));
+    return n;
+  }
+
+  // Position of the p_k-th set bit (0-based), or npos if there are fewer
+  // set bits
+  std::size_t select(std::size_t p_k) const {
+    std::size_t w = 0;
+    if (m_has_index) {
+      // Last superblock starting with at most p_k set bits before it
+      const std::size_t blocks = m_ranks.size() - 1;
+      if (p_k >= m_ranks.data()[blocks])
+        return npos;
+      std::size_t lo = 0, hi = blocks;
+      while (hi - lo > 1) {
+        const std::size_t mid = (lo + hi) / 2;
+        if (m_ranks.data()[mid] <= p_k)
+          lo = mid;
+        else
+          hi = mid;
+      }
+      p_k -= m_ranks.data()[lo];
+      w = lo * _RANK_BLOCK_WORDS;
+    }
+    for (; w < m_words.size(); ++w) {
+      std::uint64_t bits = m_words.data()[w];
+      const std::size_t cnt = popcount64(bits);
+      if (p_k < cnt) {
+        while (p_k--)
+          bits &= bits - 1; // clear lowest set bit
+        return w * 64 + ctz64(bits);
+      }
+      p_k -= cnt;
+    }
+    return npos;
+  }
+
+private:
+  std::size_t find_from(std::size_t p_pos) const noexcept {
+    if (p_pos >= m_size)
+      return npos;
+    std::size_t w = p_pos / 64;
+    std::uint64_t bits =
+        m_words.data()[w] & (~std::uint64_t(0) << (p_pos % 64));
+    while (!bits) {
+      if (++w == m_words.size())
+        return npos;
+      bits = m_words.data()[w];
+    }
+    return w * 64 + ctz64(bits);
+  }
+
+  // Clear the unused bits of the last word
+  void trim() {
+    if (m_size % 64)
+      m_words.data()[m_size / 64] &= ~(~std::uint64_t(0) << (m_size % 64));
+  }
+
+  void check_size(const BitVector &p_other) const {
+    if (m_size != p_other.m_size)
+      throw std::invalid_argument("Size mismatch");
+  }
+};
+
+} // namespace tlib
+
+#endif // TLIB_BIT_VECTOR_H
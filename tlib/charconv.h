@@ -0,0 +1,463 @@
+#ifndef TLIB_CHARCONV_H
+#define TLIB_CHARCONV_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// Buffer size that fits any number written by write_double/write_float
+#define _FLOAT_CHARS 32
+
+namespace tlib {
+
+namespace charconv_detail {
+
+// "00", "01", ..., "99"
+inline const char *digit_pairs() {
+  static const char pairs[201] =
+      "0001020304050607080910111213141516171819"
+      "2021222324252627282930313233343536373839"
+      "4041424344454647484950515253545556575859"
+      "6061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+  return pairs;
+}
+
+inline const std::uint64_t *pow10_table() {
+  static const std::uint64_t pow10[20] = {
+      1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+      10000000ull, 100000000ull, 1000000000ull, 10000000000ull, 100000000000ull,
+      1000000000000ull, 10000000000000ull, 100000000000000ull,
+      1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+      1000000000000000000ull, 10000000000000000000ull};
+  return pow10;
+}
+
+// Floating point number f * 2^e with a 64-bit significand
+struct DiyFp {
+  std::uint64_t f;
+  int e;
+};
+
+inline DiyFp normalize(DiyFp p_x) {
+  while (!(p_x.f & (std::uint64_t(1) << 63))) {
+    p_x.f <<= 1;
+    p_x.e--;
+  }
+  return p_x;
+}
+
+// Upper 64 bits of the 128-bit product, rounded
+inline DiyFp multiply(DiyFp p_x, DiyFp p_y) {
+  const std::uint64_t m32 = 0xffffffffull;
+  const std::uint64_t a = p_x.f >> 32, b = p_x.f & m32;
+  const std::uint64_t c = p_y.f >> 32, d = p_y.f & m32;
+  const std::uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+  std::uint64_t tmp = (bd >> 32) + (ad & m32) + (bc & m32);
+  tmp += std::uint64_t(1) << 31;
+  return DiyFp{ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), p_x.e + p_y.e + 64};
+}
+
+// Normalized 10^k for k = -348, -340, ..., 340
+inline DiyFp cached_power(std::size_t p_idx) {
+  static const std::uint64_t f[87] = {
+      0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull,
+      0xcf42894a5dce35eaull, 0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull,
+      0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full, 0xbe5691ef416bd60cull,
+      0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+      0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull,
+      0xc21094364dfb5637ull, 0x9096ea6f3848984full, 0xd77485cb25823ac7ull,
+      0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull, 0xb23867fb2a35b28eull,
+      0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+      0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull,
+      0xb5b5ada8aaff80b8ull, 0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull,
+      0x964e858c91ba2655ull, 0xdff9772470297ebdull, 0xa6dfbd9fb8e5b88full,
+      0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+      0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull,
+      0xaa242499697392d3ull, 0xfd87b5f28300ca0eull, 0xbce5086492111aebull,
+      0x8cbccc096f5088ccull, 0xd1b71758e219652cull, 0x9c40000000000000ull,
+      0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+      0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull,
+      0x9f4f2726179a2245ull, 0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull,
+      0x83c7088e1aab65dbull, 0xc45d1df942711d9aull, 0x924d692ca61be758ull,
+      0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+      0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull,
+      0x952ab45cfa97a0b3ull, 0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull,
+      0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull, 0x88fcf317f22241e2ull,
+      0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+      0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull,
+      0x8bab8eefb6409c1aull, 0xd01fef10a657842cull, 0x9b10a4e5e9913129ull,
+      0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull, 0x80444b5e7aa7cf85ull,
+      0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+      0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull,
+  };
+  static const short e[87] = {
+      -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+      -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+      -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+      -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+      -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+      109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+      375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+      641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+      907, 933, 960, 986, 1013, 1039, 1066,
+  };
+  return DiyFp{f[p_idx], e[p_idx]};
+}
+
+// Cached power c = 10^-k such that the binary exponent of w * c lands in
+// [-60, -32] for a normalized w with exponent p_e
+inline DiyFp cached_power_for(int p_e, int &p_k) {
+  const double dk = (-61 - p_e) * 0.30102999566398114 + 347;
+  int k = static_cast<int>(dk);
+  if (dk - k > 0.0)
+    k++;
+  const std::size_t idx = static_cast<std::size_t>((k >> 3) + 1);
+  p_k = -(-348 + static_cast<int>(idx << 3));
+  return cached_power(idx);
+}
+
+inline void grisu_round(char *p_buf, int p_len, std::uint64_t p_delta,
+                        std::uint64_t p_rest, std::uint64_t p_ten_kappa,
+                        std::uint64_t p_wp_w) {
+  while (p_rest < p_wp_w && p_delta - p_rest >= p_ten_kappa &&
+         (p_rest + p_ten_kappa < p_wp_w ||
+          p_wp_w - p_rest > p_rest + p_ten_kappa - p_wp_w)) {
+    p_buf[p_len - 1]--;
+    p_rest += p_ten_kappa;
+  }
+}
+
+inline int count_digits(std::uint64_t p_val) {
+  int n = 1;
+  for (;;) {
+    if (p_val < 10)
+      return n;
+    if (p_val < 100)
+      return n + 1;
+    if (p_val < 1000)
+      return n + 2;
+    if (p_val < 10000)
+      return n + 3;
+    p_val /= 10000;
+    n += 4;
+  }
+}
+
+// Generate the shortest digits of W within the interval (Mp - delta, Mp)
+inline void digit_gen(DiyFp p_w, DiyFp p_mp, std::uint64_t p_delta,
+                      char *p_buf, int &p_len, int &p_k) {
+  const std::uint64_t *pow10 = pow10_table();
+  const DiyFp one{std::uint64_t(1) << -p_mp.e, p_mp.e};
+  const std::uint64_t wp_w = p_mp.f - p_w.f;
+  std::uint32_t p1 = static_cast<std::uint32_t>(p_mp.f >> -one.e);
+  std::uint64_t p2 = p_mp.f & (one.f - 1);
+  int kappa = count_digits(p1);
+  p_len = 0;
+
+  while (kappa > 0) {
+    const std::uint32_t div = static_cast<std::uint32_t>(pow10[kappa - 1]);
+    const std::uint32_t d = p1 / div;
+    p1 %= div;
+    if (d || p_len)
+      p_buf[p_len++] = static_cast<char>('0' + d);
+    kappa--;
+    const std::uint64_t rest = (static_cast<std::uint64_t>(p1) << -one.e) + p2;
+    if (rest <= p_delta) {
+      p_k += kappa;
+      grisu_round(p_buf, p_len, p_delta, rest, pow10[kappa] << -one.e, wp_w);
+      return;
+    }
+  }
+
+  for (;;) {
+    p2 *= 10;
+    p_delta *= 10;
+    const char d = static_cast<char>(p2 >> -one.e);
+    if (d || p_len)
+      p_buf[p_len++] = static_cast<char>('0' + d);
+    p2 &= one.f - 1;
+    kappa--;
+    if (p2 < p_delta) {
+      p_k += kappa;
+      const int idx = -kappa;
+      grisu_round(p_buf, p_len, p_delta, p2, one.f,
+                  wp_w * (idx < 20 ? pow10[idx] : 0));
+      return;
+    }
+  }
+}
+
+// Grisu2: digits and decimal exponent of a positive finite value f * 2^e.
+// The result always reads back as the same value, and is the shortest such
+// digit string in all but rare cases.
+inline void grisu2(DiyFp p_v, bool p_lower_closer, char *p_buf, int &p_len,
+                   int &p_k) {
+  const DiyFp plus = normalize(DiyFp{(p_v.f << 1) + 1, p_v.e - 1});
+  DiyFp minus = p_lower_closer ? DiyFp{(p_v.f << 2) - 1, p_v.e - 2}
+                               : DiyFp{(p_v.f << 1) - 1, p_v.e - 1};
+  minus.f <<= minus.e - plus.e;
+  minus.e = plus.e;
+
+  const DiyFp c_mk = cached_power_for(plus.e, p_k);
+  const DiyFp w = multiply(normalize(p_v), c_mk);
+  DiyFp wp = multiply(plus, c_mk);
+  DiyFp wm = multiply(minus, c_mk);
+  wm.f++;
+  wp.f--;
+  digit_gen(w, wp, wp.f - wm.f, p_buf, p_len, p_k);
+}
+
+// Lay out digits * 10^k like JavaScript's Number.prototype.toString: plain
+// notation for magnitudes in [1e-6, 1e21), scientific otherwise
+inline char *format_decimal(char *p_dst, const char *p_digits, int p_len,
+                            int p_k) {
+  const int point = p_len + p_k; // position of the decimal point
+  if (p_k >= 0 && point <= 21) {
+    std::memcpy(p_dst, p_digits, p_len);
+    std::memset(p_dst + p_len, '0', p_k);
+    return p_dst + point;
+  }
+  if (point > 0 && point <= 21) {
+    std::memcpy(p_dst, p_digits, point);
+    p_dst[point] = '.';
+    std::memcpy(p_dst + point + 1, p_digits + point, p_len - point);
+    return p_dst + p_len + 1;
+  }
+  if (point > -6 && point <= 0) {
+    p_dst[0] = '0';
+    p_dst[1] = '.';
+    std::memset(p_dst + 2, '0', -point);
+    std::memcpy(p_dst + 2 - point, p_digits, p_len);
+    return p_dst + 2 - point + p_len;
+  }
+  *p_dst++ = p_digits[0];
+  if (p_len > 1) {
+    *p_dst++ = '.';
+    std::memcpy(p_dst, p_digits + 1, p_len - 1);
+    p_dst += p_len - 1;
+  }
+  *p_dst++ = 'e';
+  int exp = point - 1;
+  if (exp < 0) {
+    *p_dst++ = '-';
+    exp = -exp;
+  } else {
+    *p_dst++ = '+';
+  }
+  if (exp >= 100)
+    *p_dst++ = static_cast<char>('0' + exp / 100);
+  if (exp >= 10)
+    *p_dst++ = static_cast<char>('0' + exp / 10 % 10);
+  *p_dst++ = static_cast<char>('0' + exp % 10);
+  return p_dst;
+}
+
+inline char *write_special(char *p_dst, bool p_neg, bool p_nan, bool p_zero) {
+  if (p_nan) {
+    std::memcpy(p_dst, "nan", 3);
+    return p_dst + 3;
+  }
+  if (p_neg)
+    *p_dst++ = '-';
+  if (p_zero) {
+    *p_dst = '0';
+    return p_dst + 1;
+  }
+  std::memcpy(p_dst, "inf", 3);
+  return p_dst + 3;
+}
+
+} // namespace charconv_detail
+
+// Number of characters write_int needs for p_val
+template <typename T> std::size_t int_length(T p_val) {
+  static_assert(std::is_integral<T>::value, "int_length needs an integer");
+  using U = typename std::make_unsigned<T>::type;
+  const bool neg = p_val < 0;
+  // Cast back to U: for types narrower than int the subtraction is done
+  // in int and would go negative
+  const U mag = neg ? static_cast<U>(U(0) - static_cast<U>(p_val))
+                    : static_cast<U>(p_val);
+  return neg + charconv_detail::count_digits(mag);
+}
+
+// Write the decimal digits of p_val at p_dst, two digits per step from a
+// lookup table. Returns one past the last character; no terminator.
+template <typename T> char *write_int(char *p_dst, T p_val) {
+  static_assert(std::is_integral<T>::value, "write_int needs an integer");
+  using U = typename std::make_unsigned<T>::type;
+  const char *pairs = charconv_detail::digit_pairs();
+  const bool neg = p_val < 0;
+  std::uint64_t mag = neg ? static_cast<U>(U(0) - static_cast<U>(p_val))
+                          : static_cast<U>(p_val);
+  if (neg)
+    *p_dst++ = '-';
+
+  char *end = p_dst + charconv_detail::count_digits(mag);
+  char *pos = end;
+  while (mag >= 100) {
+    const std::size_t idx = static_cast<std::size_t>(mag % 100) * 2;
+    mag /= 100;
+    *--pos = pairs[idx + 1];
+    *--pos = pairs[idx];
+  }
+  if (mag >= 10) {
+    *--pos = pairs[mag * 2 + 1];
+    *--pos = pairs[mag * 2];
+  } else {
+    *--pos = static_cast<char>('0' + mag);
+  }
+  return end;
+}
+
+// Write the shortest representation of p_val that reads back to the same
+// double. p_dst needs room for _FLOAT_CHARS characters. Returns one past the
+// last character; no terminator.
+inline char *write_double(char *p_dst, double p_val) {
+  using namespace charconv_detail;
+  std::uint64_t u;
+  std::memcpy(&u, &p_val, sizeof(u));
+  const bool neg = u >> 63;
+  const int biased = static_cast<int>((u >> 52) & 0x7ff);
+  const std::uint64_t sig = u & ((std::uint64_t(1) << 52) - 1);
+  if (biased == 0x7ff || (biased == 0 && sig == 0))
+    return write_special(p_dst, neg, biased == 0x7ff && sig, biased == 0);
+
+  const DiyFp v = biased ? DiyFp{sig | (std::uint64_t(1) << 52), biased - 1075}
+                         : DiyFp{sig, -1074};
+  char digits[20];
+  int len = 0, k = 0;
+  grisu2(v, sig == 0 && biased > 1, digits, len, k);
+  if (neg)
+    *p_dst++ = '-';
+  return format_decimal(p_dst, digits, len, k);
+}
+
+// Same as write_double, shortest for float precision
+inline char *write_float(char *p_dst, float p_val) {
+  using namespace charconv_detail;
+  std::uint32_t u;
+  std::memcpy(&u, &p_val, sizeof(u));
+  const bool neg = u >> 31;
+  const int biased = static_cast<int>((u >> 23) & 0xff);
+  const std::uint64_t sig = u & ((std::uint32_t(1) << 23) - 1);
+  if (biased == 0xff || (biased == 0 && sig == 0))
+    return write_special(p_dst, neg, biased == 0xff && sig, biased == 0);
+
+  const DiyFp v = biased ? DiyFp{sig | (std::uint64_t(1) << 23), biased - 150}
+                         : DiyFp{sig, -149};
+  char digits[20];
+  int len = 0, k = 0;
+  grisu2(v, sig == 0 && biased > 1, digits, len, k);
+  if (neg)
+    *p_dst++ = '-';
+  return format_decimal(p_dst, digits, len, k);
+}
+
+// Parse a whole NUL-terminated decimal integer with an optional sign.
+// Throws std::invalid_argument if the text is not an integer and
+// std::out_of_range if it does not fit in a long long.
+inline long long parse_int(const char *p_src) {
+  const char *p = p_src;
+  if (!p)
+    throw std::invalid_argument("Not an integer");
+  const bool neg = *p == '-';
+  if (*p == '-' || *p == '+')
+    ++p;
+  if (*p < '0' || *p > '9')
+    throw std::invalid_argument("Not an integer");
+
+  const std::uint64_t limit =
+      static_cast<std::uint64_t>(std::numeric_limits<long long>::max()) + neg;
+  std::uint64_t mag = 0;
+  for (; *p >= '0' && *p <= '9'; ++p) {
+    const unsigned d = *p - '0';
+    if (mag > (limit - d) / 10)
+      throw std::out_of_range("Integer out of range");
+    mag = mag * 10 + d;
+  }
+  if (*p)
+    throw std::invalid_argument("Not an integer");
+  return neg ? static_cast<long long>(0 - mag) : static_cast<long long>(mag);
+}
+
+// Parse a whole NUL-terminated decimal number. Up to 19 significant digits
+// with a decimal exponent of at most 22 take an exact fast path: the digits
+// and the power of ten are both exact doubles, so one multiplication or
+// division rounds correctly. Everything else (long inputs, huge exponents,
+// inf, nan, hex) goes through strtod. Throws std::invalid_argument on
+// malformed input.
+inline double parse_double(const char *p_src) {
+  static const double exact_pow10[23] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  if (!p_src)
+    throw std::invalid_argument("Not a number");
+
+  const char *p = p_src;
+  const bool neg = *p == '-';
+  if (*p == '-' || *p == '+')
+    ++p;
+
+  std::uint64_t mant = 0;
+  int ndigits = 0; // significant digits in mant
+  int exp10 = 0;
+  bool any = false, exact = true;
+  for (; *p >= '0' && *p <= '9'; ++p) {
+    any = true;
+    if (ndigits < 19) {
+      mant = mant * 10 + (*p - '0');
+      ndigits += mant != 0;
+    } else {
+      exp10++;
+      exact &= *p == '0';
+    }
+  }
+  if (*p == '.') {
+    for (++p; *p >= '0' && *p <= '9'; ++p) {
+      any = true;
+      if (ndigits < 19) {
+        mant = mant * 10 + (*p - '0');
+        ndigits += mant != 0;
+        exp10--;
+      } else {
+        exact &= *p == '0';
+      }
+    }
+  }
+  if (any && (*p == 'e' || *p == 'E')) {
+    const char *q = p + 1;
+    const bool eneg = *q == '-';
+    if (*q == '-' || *q == '+')
+      ++q;
+    if (*q >= '0' && *q <= '9') {
+      int e = 0;
+      for (; *q >= '0' && *q <= '9'; ++q)
+        e = e < 10000 ? e * 10 + (*q - '0') : e;
+      exp10 += eneg ? -e : e;
+      p = q;
+    }
+  }
+
+  if (any && !*p && exact && mant <= (std::uint64_t(1) << 53) &&
+      exp10 >= -22 && exp10 <= 22) {
+    double res = static_cast<double>(mant);
+    res = exp10 < 0 ? res / exact_pow10[-exp10] : res * exact_pow10[exp10];
+    return neg ? -res : res;
+  }
+
+  char *end = nullptr;
+  const double res = std::strtod(p_src, &end);
+  if (end == p_src || *end)
+    throw std::invalid_argument("Not a number");
+  return res;
+}
+
+} // namespace tlib
+
+#endif // TLIB_CHARCONV_H
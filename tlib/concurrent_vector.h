@@ -0,0 +1,238 @@
+#ifndef TLIB_CONCURRENT_VECTOR_H
+#define TLIB_CONCURRENT_VECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+// log2 of the number of elements in the first segment
+#define _SEGMENT_MIN_LOG 3
+
+namespace tlib {
+
+// Grow-only vector that many threads can append to without a lock.
+// Elements live in segments whose sizes double (8, 16, 32, ...), so growing
+// only ever adds a segment: elements never move, and pointers, references
+// and indices stay valid until clear() or destruction.
+//
+// push_back() and grow_by() claim indices with one atomic add, and any
+// thread that finds a segment it needs missing allocates it and installs it
+// with a compare-and-swap, so no append ever waits for another. Threads
+// racing for the same segment may each allocate a copy briefly; the losers
+// free theirs. If an allocation throws, the indices claimed by that call
+// are never written, but later appends are not affected.
+//
+// size() counts claimed indices, which includes elements another thread is
+// still writing, and possibly ones whose segment is not allocated yet.
+// Indexing and iteration during appends never touch missing memory: they
+// throw out_of_range for such an index instead. The element itself is safe
+// to read once the call that appended it has returned and that is made
+// visible to the reader, e.g. by joining the writer or by passing the
+// index through an atomic.
+//
+// Like Vector, T must be default constructible: segments are allocated with
+// new T[] and appending assigns into them.
+template <typename T> class ConcurrentVector {
+private:
+  static constexpr std::size_t max_segments = 64 - _SEGMENT_MIN_LOG;
+
+  std::atomic<T *> m_segs[max_segments];
+  std::atomic<std::size_t> m_size;
+
+  static std::size_t floor_log2(std::size_t p_x) noexcept {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(p_x);
+#else
+    std::size_t n = 0;
+    while (p_x >>= 1)
+      ++n;
+    return n;
+#endif
+  }
+
+  // Segment k holds indices [first(k), first(k) + seg_size(k)), where
+  // first(k) = seg_size(k) - seg_size(0)
+  static std::size_t segment_of(std::size_t p_i) noexcept {
+    return floor_log2(p_i + (std::size_t(1) << _SEGMENT_MIN_LOG)) -
+           _SEGMENT_MIN_LOG;
+  }
+  static std::size_t seg_size(std::size_t p_k) noexcept {
+    return std::size_t(1) << (p_k + _SEGMENT_MIN_LOG);
+  }
+  static std::size_t seg_first(std::size_t p_k) noexcept {
+    return seg_size(p_k) - seg_size(0);
+  }
+
+public:
+  struct ConcurrentIterator {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+
+    ConcurrentIterator(ConcurrentVector *p_vec, std::size_t p_pos)
+        : m_vec(p_vec), m_pos(p_pos){};
+
+    reference operator*() const { return m_vec->element(m_pos); }
+    pointer operator->() const { return &operator*(); }
+
+    ConcurrentIterator &operator++() {
+      m_pos++;
+      return *this;
+    }
+    ConcurrentIterator operator++(int) {
+      ConcurrentIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const ConcurrentIterator x,
+                           const ConcurrentIterator y) {
+      return x.m_pos == y.m_pos;
+    }
+    friend bool operator!=(const ConcurrentIterator x,
+                           const ConcurrentIterator y) {
+      return x.m_pos != y.m_pos;
+    }
+
+  private:
+    ConcurrentVector *m_vec;
+    std::size_t m_pos;
+  };
+
+  using Iterator = ConcurrentIterator;
+
+  // Construct/copy/destroy
+  ConcurrentVector() : m_size(0) {
+    for (std::size_t k = 0; k < max_segments; ++k)
+      m_segs[k].store(nullptr, std::memory_order_relaxed);
+  }
+
+  // Not copyable or movable: other threads may hold element addresses
+  ConcurrentVector(const ConcurrentVector &) = delete;
+  ConcurrentVector &operator=(const ConcurrentVector &) = delete;
+
+  // Destructor
+  ~ConcurrentVector() { release(); }
+
+  // Capacity
+  inline bool empty() const noexcept { return size() == 0; }
+
+  std::size_t size() const noexcept {
+    return m_size.load(std::memory_order_acquire);
+  }
+
+  // Elements that fit in the segments allocated so far
+  std::size_t capacity() const noexcept {
+    std::size_t k = 0;
+    while (k < max_segments && m_segs[k].load(std::memory_order_acquire))
+      ++k;
+    return k ? seg_first(k - 1) + seg_size(k - 1) : 0;
+  }
+
+  // Allocate the segments for the first p_sz elements. Safe to call
+  // concurrently with appends.
+  void reserve(std::size_t p_sz) {
+    if (p_sz == 0)
+      return;
+    for (std::size_t k = 0; k <= segment_of(p_sz - 1); ++k)
+      allocate(k);
+  }
+
+  // Element access. Safe concurrently with appends, throwing for an index
+  // whose segment is not installed yet; see the class comment for when the
+  // element itself has been written.
+  T &operator[](std::size_t p_i) {
+    if (p_i < size())
+      return element(p_i);
+    throw std::out_of_range("Out of range");
+  }
+  const T &operator[](std::size_t p_i) const {
+    if (p_i < size())
+      return element(p_i);
+    throw std::out_of_range("Out of range");
+  }
+  T &at(std::size_t p_i) { return operator[](p_i); }
+  const T &at(std::size_t p_i) const { return operator[](p_i); }
+
+  T &front() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return element(0);
+  }
+
+  // Modifiers
+  // Append p_el and return its index
+  std::size_t push_back(const T &p_el) {
+    const std::size_t i = m_size.fetch_add(1, std::memory_order_acq_rel);
+    install(i, 1);
+    element(i) = p_el;
+    return i;
+  }
+
+  // Append p_n copies of p_val and return the index of the first. The new
+  // elements are contiguous in index but may span segments.
+  std::size_t grow_by(std::size_t p_n, const T &p_val = T()) {
+    const std::size_t first =
+        m_size.fetch_add(p_n, std::memory_order_acq_rel);
+    if (p_n == 0)
+      return first;
+    install(first, p_n);
+    for (std::size_t i = first; i < first + p_n; ++i)
+      element(i) = p_val;
+    return first;
+  }
+
+  // Free all segments. Not safe concurrently with any other member.
+  void clear() {
+    release();
+    m_size.store(0, std::memory_order_release);
+  }
+
+  // Iterator. Covers the indices claimed before end() was called.
+  Iterator begin() { return Iterator(this, 0); }
+  Iterator end() { return Iterator(this, size()); }
+
+private:
+  // Throws if the segment of p_i is not installed yet
+  T &element(std::size_t p_i) const {
+    const std::size_t k = segment_of(p_i);
+    T *seg = m_segs[k].load(std::memory_order_acquire);
+    if (!seg)
+      throw std::out_of_range("Element not allocated yet");
+    return seg[p_i - seg_first(k)];
+  }
+
+  // Allocate segment p_k unless it exists. A thread that loses the race to
+  // install it frees its own copy.
+  void allocate(std::size_t p_k) {
+    if (m_segs[p_k].load(std::memory_order_acquire))
+      return;
+    T *seg = new T[seg_size(p_k)];
+    T *expected = nullptr;
+    if (!m_segs[p_k].compare_exchange_strong(expected, seg,
+                                             std::memory_order_acq_rel))
+      delete[] seg;
+  }
+
+  // Make sure the segments holding [p_first, p_first + p_n) exist
+  void install(std::size_t p_first, std::size_t p_n) {
+    const std::size_t last = segment_of(p_first + p_n - 1);
+    for (std::size_t k = segment_of(p_first); k <= last; ++k)
+      allocate(k);
+  }
+
+  void release() {
+    for (std::size_t k = 0; k < max_segments; ++k)
+      delete[] m_segs[k].exchange(nullptr, std::memory_order_relaxed);
+  }
+};
+
+template <typename T> constexpr std::size_t ConcurrentVector<T>::max_segments;
+
+} // namespace tlib
+
+#endif // TLIB_CONCURRENT_VECTOR_H
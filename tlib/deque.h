@@ -0,0 +1,311 @@
+#ifndef TLIB_DEQUE_H
+#define TLIB_DEQUE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+#define _DEQUE_MIN_MAP 8
+
+namespace tlib {
+
+// Double-ended queue made of fixed-size blocks. A map of block pointers grows
+// on demand at either end, so push/pop at both ends are amortized O(1) and
+// elements never move once written. Blocks freed by pops are kept and reused.
+template <typename T> class Deque {
+public:
+  // Elements per block: about 512 bytes worth, kept a power of two so that
+  // indexing is a shift and a mask.
+  static constexpr std::size_t block_size = sizeof(T) <= 4    ? 128
+                                            : sizeof(T) <= 8  ? 64
+                                            : sizeof(T) <= 16 ? 32
+                                            : sizeof(T) <= 32 ? 16
+                                                              : 8;
+
+  struct DequeIterator {
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+
+    DequeIterator(T **p_map, std::size_t p_pos) : m_map(p_map), m_pos(p_pos){};
+
+    reference operator*() const {
+      return m_map[m_pos / block_size][m_pos % block_size];
+    }
+    pointer operator->() const { return &operator*(); }
+    reference operator[](difference_type p_n) const { return *(*this + p_n); }
+
+    DequeIterator &operator++() {
+      m_pos++;
+      return *this;
+    }
+    DequeIterator operator++(int) {
+      DequeIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    DequeIterator &operator--() {
+      m_pos--;
+      return *this;
+    }
+    DequeIterator operator--(int) {
+      DequeIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    DequeIterator &operator+=(difference_type p_n) {
+      m_pos += p_n;
+      return *this;
+    }
+    DequeIterator &operator-=(difference_type p_n) {
+      m_pos -= p_n;
+      return *this;
+    }
+    friend DequeIterator operator+(DequeIterator x, difference_type p_n) {
+      return x += p_n;
+    }
+    friend DequeIterator operator+(difference_type p_n, DequeIterator x) {
+      return x += p_n;
+    }
+    friend DequeIterator operator-(DequeIterator x, difference_type p_n) {
+      return x -= p_n;
+    }
+    friend difference_type operator-(const DequeIterator x,
+                                     const DequeIterator y) {
+      return static_cast<difference_type>(x.m_pos) -
+             static_cast<difference_type>(y.m_pos);
+    }
+
+    friend bool operator==(const DequeIterator x, const DequeIterator y) {
+      return x.m_pos == y.m_pos;
+    }
+    friend bool operator!=(const DequeIterator x, const DequeIterator y) {
+      return x.m_pos != y.m_pos;
+    }
+    friend bool operator>(const DequeIterator x, const DequeIterator y) {
+      return x.m_pos > y.m_pos;
+    }
+    friend bool operator>=(const DequeIterator x, const DequeIterator y) {
+      return x.m_pos >= y.m_pos;
+    }
+    friend bool operator<(const DequeIterator x, const DequeIterator y) {
+      return x.m_pos < y.m_pos;
+    }
+    friend bool operator<=(const DequeIterator x, const DequeIterator y) {
+      return x.m_pos <= y.m_pos;
+    }
+
+  private:
+    T **m_map;
+    std::size_t m_pos; // position counted from the start of the map
+  };
+
+  using Iterator = DequeIterator;
+
+private:
+  T **m_map;              // block pointers, nullptr where not allocated
+  std::size_t m_map_size; // number of slots in m_map
+  std::size_t m_start;    // position of the first element in the map
+  std::size_t m_size;
+
+public:
+  // Construct/copy/destroy
+  Deque() : m_map(nullptr), m_map_size(0), m_start(0), m_size(0) {}
+
+  Deque(std::size_t p_sz) : Deque() { resize(p_sz); }
+
+  Deque(std::size_t p_sz, const T &p_val) : Deque() {
+    for (std::size_t i = 0; i < p_sz; ++i)
+      push_back(p_val);
+  }
+
+  Deque(std::initializer_list<T> p_lst) : Deque() {
+    for (const T &val : p_lst)
+      push_back(val);
+  }
+
+  // Copy constructor
+  Deque(const Deque &p_copy_src) : Deque() {
+    for (std::size_t i = 0; i < p_copy_src.size(); ++i)
+      push_back(p_copy_src[i]);
+  }
+
+  // Copy assignment
+  Deque &operator=(const Deque &p_copy_src) {
+    if (this != &p_copy_src) {
+      clear();
+      for (std::size_t i = 0; i < p_copy_src.size(); ++i)
+        push_back(p_copy_src[i]);
+    }
+    return *this;
+  }
+
+  // Move constructor
+  Deque(Deque &&p_move_src)
+      : m_map(p_move_src.m_map), m_map_size(p_move_src.m_map_size),
+        m_start(p_move_src.m_start), m_size(p_move_src.m_size) {
+    p_move_src.m_map = nullptr;
+    p_move_src.m_map_size = p_move_src.m_start = p_move_src.m_size = 0;
+  }
+
+  // Move assignment
+  Deque &operator=(Deque &&p_move_src) {
+    if (this != &p_move_src) {
+      release();
+      m_map = p_move_src.m_map;
+      m_map_size = p_move_src.m_map_size;
+      m_start = p_move_src.m_start;
+      m_size = p_move_src.m_size;
+
+      p_move_src.m_map = nullptr;
+      p_move_src.m_map_size = p_move_src.m_start = p_move_src.m_size = 0;
+    }
+    return *this;
+  }
+
+  // Destructor
+  ~Deque() { release(); }
+
+  // Capacity
+  inline bool empty() const noexcept { return m_size == 0; }
+
+  std::size_t size() const noexcept { return m_size; }
+
+  void resize(std::size_t p_sz) {
+    while (m_size < p_sz)
+      push_back(T{});
+    while (m_size > p_sz)
+      pop_back();
+  }
+
+  // Element access
+  T &operator[](std::size_t p_i) {
+    if (p_i < m_size)
+      return elem(m_start + p_i);
+    throw std::out_of_range("Out of range");
+  }
+  const T &operator[](std::size_t p_i) const {
+    if (p_i < m_size)
+      return elem(m_start + p_i);
+    throw std::out_of_range("Out of range");
+  }
+  T &at(std::size_t p_i) { return operator[](p_i); }
+  const T &at(std::size_t p_i) const { return operator[](p_i); }
+
+  T &front() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return elem(m_start);
+  }
+
+  T &back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return elem(m_start + m_size - 1);
+  }
+
+  // Modifiers
+  void clear() noexcept {
+    m_start = m_map_size * block_size / 2;
+    m_size = 0;
+  }
+
+  void push_back(const T &p_val) {
+    if (m_start + m_size == m_map_size * block_size)
+      remap();
+    slot(m_start + m_size) = p_val;
+    ++m_size;
+  }
+
+  void pop_back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    --m_size;
+  }
+
+  void push_front(const T &p_val) {
+    if (m_start == 0)
+      remap();
+    slot(m_start - 1) = p_val;
+    --m_start;
+    ++m_size;
+  }
+
+  void pop_front() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    ++m_start;
+    --m_size;
+  }
+
+  // Iterator
+  Iterator begin() { return Iterator(m_map, m_start); }
+  Iterator end() { return Iterator(m_map, m_start + m_size); }
+
+private:
+  T &elem(std::size_t p_pos) const {
+    return m_map[p_pos / block_size][p_pos % block_size];
+  }
+
+  // Element slot at p_pos, allocating its block if needed
+  T &slot(std::size_t p_pos) {
+    T *&blk = m_map[p_pos / block_size];
+    if (!blk)
+      blk = new T[block_size];
+    return blk[p_pos % block_size];
+  }
+
+  // Make room for at least one more block at both ends. Always allocates a
+  // new map, the same size if the blocks in use take up less than half of
+  // the old one and double otherwise, and copies the block pointers in use
+  // to its center. Spare blocks move to the remaining slots.
+  void remap() {
+    const std::size_t first = m_start / block_size;
+    const std::size_t used =
+        m_size == 0 ? 0 : (m_start + m_size - 1) / block_size - first + 1;
+
+    std::size_t new_map_size = m_map_size;
+    if (2 * (used + 2) > m_map_size)
+      new_map_size = m_map_size * 2 < used + 2 ? used + 2 : m_map_size * 2;
+    if (new_map_size < _DEQUE_MIN_MAP)
+      new_map_size = _DEQUE_MIN_MAP;
+
+    T **new_map = new T *[new_map_size]();
+    const std::size_t new_first = (new_map_size - used) / 2;
+    for (std::size_t i = 0; i < used; ++i)
+      new_map[new_first + i] = m_map[first + i];
+
+    // Hand the spare blocks to the empty slots
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < m_map_size; ++i) {
+      if ((i >= first && i < first + used) || !m_map[i])
+        continue;
+      while (new_map[j])
+        ++j;
+      new_map[j] = m_map[i];
+    }
+
+    delete[] m_map;
+    m_map = new_map;
+    m_map_size = new_map_size;
+    m_start = new_first * block_size + m_start % block_size;
+  }
+
+  void release() {
+    for (std::size_t i = 0; i < m_map_size; ++i)
+      delete[] m_map[i];
+    delete[] m_map;
+    m_map = nullptr;
+    m_map_size = m_start = m_size = 0;
+  }
+};
+
+template <typename T> constexpr std::size_t Deque<T>::block_size;
+
+} // namespace tlib
+
+#endif // TLIB_DEQUE_H
@@ -0,0 +1,119 @@
+#ifndef TLIB_FIXED_STRING_H
+#define TLIB_FIXED_STRING_H
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace tlib {
+
+// NUL-terminated string with inline storage for up to N characters. Fully
+// constexpr and trivially destructible, for string tables built at compile
+// time.
+template <std::size_t N> class FixedString {
+private:
+  char m_buf[N + 1];
+  std::size_t m_size;
+
+public:
+  // Constructor
+  constexpr FixedString() : m_buf{}, m_size(0) {}
+
+  constexpr FixedString(const char *p_src) : m_buf{}, m_size(0) {
+    append(p_src);
+  }
+
+  // Capacity
+  constexpr bool empty() const noexcept { return m_size == 0; }
+
+  constexpr std::size_t size() const noexcept { return m_size; }
+
+  static constexpr std::size_t capacity() noexcept { return N; }
+
+  // Element access
+  constexpr char &operator[](std::size_t p_i) {
+    if (p_i < m_size)
+      return m_buf[p_i];
+    throw std::out_of_range("Out of range");
+  }
+  constexpr const char &operator[](std::size_t p_i) const {
+    if (p_i < m_size)
+      return m_buf[p_i];
+    throw std::out_of_range("Out of range");
+  }
+
+  constexpr const char *c_str() const noexcept { return m_buf; }
+  constexpr const char *data() const noexcept { return m_buf; }
+
+  // Casting operator
+  constexpr operator const char *() const noexcept { return m_buf; }
+
+  // Modifiers
+  constexpr void clear() noexcept {
+    m_size = 0;
+    m_buf[0] = '\0';
+  }
+
+  constexpr void push_back(char p_ch) {
+    if (m_size == N)
+      throw std::length_error("FixedString capacity exceeded");
+    m_buf[m_size++] = p_ch;
+    m_buf[m_size] = '\0';
+  }
+
+  // p_src may point into this string. Nothing is appended if the result
+  // would not fit.
+  constexpr FixedString &append(const char *p_src) {
+    std::size_t n = 0;
+    while (p_src && p_src[n])
+      ++n;
+    return append(p_src, n);
+  }
+
+  template <std::size_t M>
+  constexpr FixedString &append(const FixedString<M> &p_other) {
+    return append(p_other.c_str(), p_other.size());
+  }
+
+  constexpr FixedString &append(const char *p_src, std::size_t p_n) {
+    if (p_n > N - m_size)
+      throw std::length_error("FixedString capacity exceeded");
+    // The length is fixed before copying, so a source inside this string
+    // only ever reads characters that were there before the append
+    for (std::size_t i = 0; i < p_n; ++i)
+      m_buf[m_size + i] = p_src[i];
+    m_size += p_n;
+    m_buf[m_size] = '\0';
+    return *this;
+  }
+
+  // Equality
+  template <std::size_t M>
+  constexpr bool operator==(const FixedString<M> &p_other) const {
+    return *this == p_other.c_str();
+  }
+  template <std::size_t M>
+  constexpr bool operator!=(const FixedString<M> &p_other) const {
+    return !operator==(p_other);
+  }
+
+  constexpr bool operator==(const char *p_cstr) const {
+    std::size_t i = 0;
+    for (; i < m_size; ++i)
+      if (p_cstr[i] != m_buf[i])
+        return false;
+    return p_cstr[i] == '\0';
+  }
+  constexpr bool operator!=(const char *p_cstr) const {
+    return !operator==(p_cstr);
+  }
+};
+
+// FixedString sized to a string literal
+template <std::size_t M>
+constexpr FixedString<M - 1> make_fixed_string(const char (&p_src)[M]) {
+  return FixedString<M - 1>(p_src);
+}
+
+} // namespace tlib
+
+#endif // TLIB_FIXED_STRING_H
@@ -0,0 +1,118 @@
+#ifndef TLIB_FIXED_VECTOR_H
+#define TLIB_FIXED_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace tlib {
+
+// Vector with inline storage for up to N elements. Everything is constexpr,
+// so tables can be built at compile time and placed in the binary; there is
+// no heap allocation and the type is trivially destructible when T is.
+template <typename T, std::size_t N> class FixedVector {
+private:
+  T m_buf[N > 0 ? N : 1];
+  std::size_t m_size;
+
+public:
+  using Iterator = T *;
+  using ConstIterator = const T *;
+
+  // Construct
+  constexpr FixedVector() : m_buf{}, m_size(0) {}
+
+  constexpr FixedVector(std::size_t p_sz, const T &p_val) : m_buf{}, m_size(0) {
+    if (p_sz > N)
+      throw std::length_error("FixedVector capacity exceeded");
+    for (; m_size < p_sz; ++m_size)
+      m_buf[m_size] = p_val;
+  }
+
+  constexpr FixedVector(std::initializer_list<T> p_lst) : m_buf{}, m_size(0) {
+    if (p_lst.size() > N)
+      throw std::length_error("FixedVector capacity exceeded");
+    for (const T &val : p_lst)
+      m_buf[m_size++] = val;
+  }
+
+  // Capacity
+  constexpr bool empty() const noexcept { return m_size == 0; }
+  constexpr bool full() const noexcept { return m_size == N; }
+
+  constexpr std::size_t size() const noexcept { return m_size; }
+
+  static constexpr std::size_t capacity() noexcept { return N; }
+
+  constexpr void resize(std::size_t p_sz) {
+    if (p_sz > N)
+      throw std::length_error("FixedVector capacity exceeded");
+    for (std::size_t i = m_size; i < p_sz; ++i)
+      m_buf[i] = T{};
+    m_size = p_sz;
+  }
+
+  // Element access
+  constexpr T &operator[](std::size_t p_i) {
+    if (p_i < m_size)
+      return m_buf[p_i];
+    throw std::out_of_range("Out of range");
+  }
+  constexpr const T &operator[](std::size_t p_i) const {
+    if (p_i < m_size)
+      return m_buf[p_i];
+    throw std::out_of_range("Out of range");
+  }
+  constexpr T &at(std::size_t p_i) { return operator[](p_i); }
+  constexpr const T &at(std::size_t p_i) const { return operator[](p_i); }
+
+  constexpr T &front() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return m_buf[0];
+  }
+  constexpr const T &front() const {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return m_buf[0];
+  }
+
+  constexpr T &back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return m_buf[m_size - 1];
+  }
+  constexpr const T &back() const {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return m_buf[m_size - 1];
+  }
+
+  constexpr T *data() noexcept { return m_buf; }
+  constexpr const T *data() const noexcept { return m_buf; }
+
+  // Modifiers
+  constexpr void clear() noexcept { m_size = 0; }
+
+  constexpr void push_back(const T &p_val) {
+    if (full())
+      throw std::length_error("FixedVector capacity exceeded");
+    m_buf[m_size++] = p_val;
+  }
+
+  constexpr void pop_back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    --m_size;
+  }
+
+  // Iterator
+  constexpr Iterator begin() noexcept { return m_buf; }
+  constexpr ConstIterator begin() const noexcept { return m_buf; }
+  constexpr Iterator end() noexcept { return m_buf + m_size; }
+  constexpr ConstIterator end() const noexcept { return m_buf + m_size; }
+};
+
+} // namespace tlib
+
+#endif // TLIB_FIXED_VECTOR_H
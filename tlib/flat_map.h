@@ -0,0 +1,242 @@
+#ifndef TLIB_FLAT_MAP_H
+#define TLIB_FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "tlib/vector.h"
+
+namespace tlib {
+
+// Sorted associative container. Keys and values live in two separate
+// tlib::Vectors kept in key order, so a search only touches the key array.
+// Lookups use a branchless binary search; a read-mostly map can additionally
+// build an Eytzinger (BFS order) copy of the keys with build_index(), which
+// gives cache-friendly searches on large maps. Any modification drops the
+// index.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class FlatMap {
+private:
+  Vector<Key> m_keys; // sorted
+  Vector<T> m_vals;   // m_vals[i] belongs to m_keys[i]
+  Compare m_comp;
+
+  // Eytzinger layout, 1-based: m_eytz[k] has children 2k and 2k + 1.
+  // m_eytz_rank[k] is the index of m_eytz[k] in m_keys.
+  Vector<Key> m_eytz;
+  Vector<std::size_t> m_eytz_rank;
+
+public:
+  // Construct/copy/destroy
+  FlatMap() : m_keys(0), m_vals(0), m_eytz(0), m_eytz_rank(0) {}
+
+  // Bulk build from unsorted (key, value) pairs. For duplicate keys the first
+  // occurrence wins, as with repeated insert().
+  template <typename InputIt>
+  FlatMap(InputIt p_first, InputIt p_last) : FlatMap() {
+    Vector<std::pair<Key, T>> tmp(0);
+    for (; p_first != p_last; ++p_first)
+      tmp.push_back(*p_first);
+    build(tmp);
+  }
+
+  FlatMap(std::initializer_list<std::pair<Key, T>> p_lst)
+      : FlatMap(p_lst.begin(), p_lst.end()) {}
+
+  // Capacity
+  inline bool empty() const noexcept { return m_keys.empty(); }
+
+  std::size_t size() const noexcept { return m_keys.size(); }
+
+  void reserve(std::size_t p_sz) {
+    m_keys.reserve(p_sz);
+    m_vals.reserve(p_sz);
+  }
+
+  // Element access
+  T &operator[](const Key &p_key) {
+    const std::size_t i = lower_bound(p_key);
+    if (i == size() || m_comp(p_key, m_keys[i]))
+      insert_at(i, p_key, T{});
+    return m_vals[i];
+  }
+
+  T &at(const Key &p_key) {
+    T *val = find(p_key);
+    if (val)
+      return *val;
+    throw std::out_of_range("Key not found");
+  }
+  const T &at(const Key &p_key) const {
+    const T *val = find(p_key);
+    if (val)
+      return *val;
+    throw std::out_of_range("Key not found");
+  }
+
+  // Sorted keys and the matching values
+  const Vector<Key> &keys() const noexcept { return m_keys; }
+  const Vector<T> &values() const noexcept { return m_vals; }
+
+  // Modifiers
+  void clear() {
+    m_keys.resize(0);
+    m_vals.resize(0);
+    drop_index();
+  }
+
+  // Returns false if the key was already present
+  bool insert(const Key &p_key, const T &p_val) {
+    const std::size_t i = lower_bound(p_key);
+    if (i < size() && !m_comp(p_key, m_keys[i]))
+      return false;
+    insert_at(i, p_key, p_val);
+    return true;
+  }
+
+  // Returns the number of elements removed
+  std::size_t erase(const Key &p_key) {
+    const std::size_t i = lower_bound(p_key);
+    if (i == size() || m_comp(p_key, m_keys[i]))
+      return 0;
+    Key *keys = m_keys.data();
+    T *vals = m_vals.data();
+    std::move(keys + i + 1, keys + size(), keys + i);
+    std::move(vals + i + 1, vals + size(), vals + i);
+    m_keys.pop_back();
+    m_vals.pop_back();
+    drop_index();
+    return 1;
+  }
+
+  // Lookup. find() returns nullptr if the key is absent.
+  T *find(const Key &p_key) {
+    const std::size_t i = index_of(p_key);
+    return i == size() ? nullptr : m_vals.data() + i;
+  }
+  const T *find(const Key &p_key) const {
+    const std::size_t i = index_of(p_key);
+    return i == size() ? nullptr : m_vals.data() + i;
+  }
+
+  std::size_t count(const Key &p_key) const {
+    return index_of(p_key) == size() ? 0 : 1;
+  }
+
+  bool contains(const Key &p_key) const { return index_of(p_key) != size(); }
+
+  // Index of the first key not less than p_key, or size()
+  std::size_t lower_bound(const Key &p_key) const {
+    return m_eytz.empty() ? binary_lower_bound(p_key)
+                          : eytzinger_lower_bound(p_key);
+  }
+
+  // Search layout. build_index() lays out a copy of the keys in Eytzinger
+  // order; worth it for large maps that are queried much more than modified.
+  void build_index() {
+    const std::size_t n = size();
+    m_eytz.resize(n + 1);
+    m_eytz_rank.resize(n + 1);
+    fill_index(0, 1);
+  }
+
+  bool has_index() const noexcept { return !m_eytz.empty(); }
+
+private:
+  void build(Vector<std::pair<Key, T>> &p_pairs) {
+    std::pair<Key, T> *first = p_pairs.data();
+    std::pair<Key, T> *last = first + p_pairs.size();
+    std::stable_sort(first, last,
+                     [this](const std::pair<Key, T> &a,
+                            const std::pair<Key, T> &b) {
+                       return m_comp(a.first, b.first);
+                     });
+    reserve(p_pairs.size());
+    for (; first != last; ++first) {
+      if (!empty() && !m_comp(m_keys.back(), first->first))
+        continue;
+      m_keys.push_back(first->first);
+      m_vals.push_back(first->second);
+    }
+  }
+
+  void insert_at(std::size_t p_i, const Key &p_key, const T &p_val) {
+    m_keys.push_back(p_key);
+    m_vals.push_back(p_val);
+    Key *keys = m_keys.data();
+    T *vals = m_vals.data();
+    std::move_backward(keys + p_i, keys + size() - 1, keys + size());
+    std::move_backward(vals + p_i, vals + size() - 1, vals + size());
+    keys[p_i] = p_key;
+    vals[p_i] = p_val;
+    drop_index();
+  }
+
+  std::size_t index_of(const Key &p_key) const {
+    const std::size_t i = lower_bound(p_key);
+    if (i < size() && !m_comp(p_key, m_keys.data()[i]))
+      return i;
+    return size();
+  }
+
+  // The loop body compiles to a conditional move; the trip count only
+  // depends on size().
+  std::size_t binary_lower_bound(const Key &p_key) const {
+    std::size_t n = size();
+    if (n == 0)
+      return 0;
+    const Key *base = m_keys.data();
+    while (n > 1) {
+      const std::size_t half = n / 2;
+      base = m_comp(base[half], p_key) ? base + half : base;
+      n -= half;
+    }
+    return (base - m_keys.data()) + m_comp(*base, p_key);
+  }
+
+  std::size_t eytzinger_lower_bound(const Key &p_key) const {
+    const Key *eytz = m_eytz.data();
+    const std::size_t n = size();
+    std::size_t k = 1;
+    while (k <= n) {
+#if defined(__GNUC__)
+      // The 16 descendants four levels down are adjacent; fetch them early
+      __builtin_prefetch(eytz + 16 * k);
+#endif
+      k = 2 * k + m_comp(eytz[k], p_key);
+    }
+    // Undo the trailing right turns and the final left turn
+#if defined(__GNUC__)
+    k >>= __builtin_ffsll(~static_cast<long long>(k));
+#else
+    while (k & 1)
+      k >>= 1;
+    k >>= 1;
+#endif
+    return k == 0 ? n : m_eytz_rank.data()[k];
+  }
+
+  // In-order walk of the implicit tree assigns sorted keys to BFS slots
+  std::size_t fill_index(std::size_t p_i, std::size_t p_k) {
+    if (p_k <= size()) {
+      p_i = fill_index(p_i, 2 * p_k);
+      m_eytz.data()[p_k] = m_keys.data()[p_i];
+      m_eytz_rank.data()[p_k] = p_i;
+      p_i = fill_index(p_i + 1, 2 * p_k + 1);
+    }
+    return p_i;
+  }
+
+  void drop_index() {
+    m_eytz.resize(0);
+    m_eytz_rank.resize(0);
+  }
+};
+
+} // namespace tlib
+
+#endif // TLIB_FLAT_MAP_H
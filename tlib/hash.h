@@ -0,0 +1,175 @@
+#ifndef TLIB_HASH_H
+#define TLIB_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "tlib/string.h"
+
+namespace tlib {
+
+namespace hash_detail {
+
+// Default secret of wyhash
+constexpr std::uint64_t secret[4] = {0x2d358dccaa6c78a5ull,
+                                     0x8bb84b93962eacc9ull,
+                                     0x4b33a62ed433d4a3ull,
+                                     0x4d5a2da51de1aa47ull};
+
+// Full 64x64 -> 128 bit multiply, low half in p_a and high half in p_b
+inline void mum(std::uint64_t &p_a, std::uint64_t &p_b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = p_a;
+  r *= p_b;
+  p_a = static_cast<std::uint64_t>(r);
+  p_b = static_cast<std::uint64_t>(r >> 64);
+#else
+  const std::uint64_t ha = p_a >> 32, la = static_cast<std::uint32_t>(p_a);
+  const std::uint64_t hb = p_b >> 32, lb = static_cast<std::uint32_t>(p_b);
+  const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const std::uint64_t t = rl + (rm0 << 32);
+  std::uint64_t c = t < rl;
+  const std::uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  p_a = lo;
+  p_b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline std::uint64_t mix(std::uint64_t p_a, std::uint64_t p_b) noexcept {
+  mum(p_a, p_b);
+  return p_a ^ p_b;
+}
+
+// Unaligned loads in host byte order, so hash values differ between little-
+// and big-endian hosts
+inline std::uint64_t read8(const unsigned char *p_src) noexcept {
+  std::uint64_t v;
+  std::memcpy(&v, p_src, 8);
+  return v;
+}
+inline std::uint64_t read4(const unsigned char *p_src) noexcept {
+  std::uint32_t v;
+  std::memcpy(&v, p_src, 4);
+  return v;
+}
+// 1 to 3 bytes
+inline std::uint64_t read3(const unsigned char *p_src,
+                           std::size_t p_len) noexcept {
+  return (std::uint64_t(p_src[0]) << 16) |
+         (std::uint64_t(p_src[p_len >> 1]) << 8) | p_src[p_len - 1];
+}
+
+} // namespace hash_detail
+
+// Hash of a byte buffer, following wyhash: inputs up to 16 bytes take a
+// single 128-bit multiply, longer ones consume 48 bytes per round in three
+// independent lanes. Not cryptographic.
+inline std::uint64_t hash_bytes(const void *p_src, std::size_t p_len,
+                                std::uint64_t p_seed = 0) noexcept {
+  using namespace hash_detail;
+  const unsigned char *p = static_cast<const unsigned char *>(p_src);
+  std::uint64_t seed = p_seed ^ mix(p_seed ^ secret[0], secret[1]);
+  std::uint64_t a, b;
+  if (p_len <= 16) {
+    if (p_len >= 4) {
+      const std::size_t off = (p_len >> 3) << 2;
+      a = (read4(p) << 32) | read4(p + off);
+      b = (read4(p + p_len - 4) << 32) | read4(p + p_len - 4 - off);
+    } else if (p_len > 0) {
+      a = read3(p, p_len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    std::size_t i = p_len;
+    if (i >= 48) {
+      std::uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+        see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+        see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i >= 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+      p += 16;
+      i -= 16;
+    }
+    // Last 16 bytes, overlapping what was already consumed
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+  }
+  a ^= secret[1];
+  b ^= seed;
+  mum(a, b);
+  return mix(a ^ secret[0] ^ p_len, b ^ secret[1]);
+}
+
+// Integer mixer (the splitmix64 finalizer). A bijection, so distinct keys
+// never collide before the table masks the result, and every input bit
+// affects every output bit.
+inline std::uint64_t hash_int(std::uint64_t p_x) noexcept {
+  p_x ^= p_x >> 30;
+  p_x *= 0xbf58476d1ce4e5b9ull;
+  p_x ^= p_x >> 27;
+  p_x *= 0x94d049bb133111ebull;
+  p_x ^= p_x >> 31;
+  return p_x;
+}
+
+// Hash functor for the Hash parameter of UnorderedMap and LruCache, in
+// place of std::hash, which is the identity for integers and so leaves the
+// low bits that a power-of-two table uses poorly distributed. Defined for
+// integers, enums, pointers, float, double, String and std::string.
+template <typename T, typename Enable = void> struct Hash;
+
+template <typename T>
+struct Hash<T, typename std::enable_if<std::is_integral<T>::value ||
+                                       std::is_enum<T>::value>::type> {
+  std::size_t operator()(T p_key) const noexcept {
+    return static_cast<std::size_t>(
+        hash_int(static_cast<std::uint64_t>(p_key)));
+  }
+};
+
+template <typename T> struct Hash<T *> {
+  std::size_t operator()(const T *p_key) const noexcept {
+    return static_cast<std::size_t>(
+        hash_int(reinterpret_cast<std::uintptr_t>(p_key)));
+  }
+};
+
+template <typename T>
+struct Hash<T, typename std::enable_if<std::is_same<T, float>::value ||
+                                       std::is_same<T, double>::value>::type> {
+  std::size_t operator()(T p_key) const noexcept {
+    // 0.0 and -0.0 compare equal, so they must hash equal
+    if (p_key == 0)
+      p_key = 0;
+    return static_cast<std::size_t>(hash_bytes(&p_key, sizeof(T)));
+  }
+};
+
+template <> struct Hash<String> {
+  std::size_t operator()(const String &p_key) const noexcept {
+    return static_cast<std::size_t>(hash_bytes(p_key.c_str(), p_key.size()));
+  }
+};
+
+template <> struct Hash<std::string> {
+  std::size_t operator()(const std::string &p_key) const noexcept {
+    return static_cast<std::size_t>(hash_bytes(p_key.data(), p_key.size()));
+  }
+};
+
+} // namespace tlib
+
+#endif // TLIB_HASH_H
@@ -0,0 +1,295 @@
+#ifndef TLIB_LRU_CACHE_H
+#define TLIB_LRU_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+#include "tlib/vector.h"
+
+namespace tlib {
+
+// Least-recently-used cache with O(1) get/put/erase. Entries live in a pool
+// of nodes (a tlib::Vector with a free list) linked into an intrusive
+// recency list by index, and an open-addressing hash index maps keys to
+// nodes, so there is no allocation per entry.
+//
+// Capacity is either an entry count or a total weight computed by a weight
+// function. When an insert goes over capacity the least recently used
+// entries are evicted and passed to the eviction callback, if any.
+//
+// Like Vector, Key and T must be default constructible.
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename Pred = std::equal_to<Key>>
+class LruCache {
+public:
+  using WeightFn = std::function<std::size_t(const Key &, const T &)>;
+  using EvictFn = std::function<void(const Key &, const T &)>;
+
+private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  struct Node {
+    Key m_key;
+    T m_val;
+    std::size_t m_hash;
+    std::size_t m_weight;
+    std::size_t m_prev; // towards most recently used
+    std::size_t m_next; // towards least recently used, or next free node
+  };
+
+  Vector<Node> m_nodes;
+  std::size_t m_free; // head of the free list
+
+  // Hash index: node index per slot, npos when empty. Size is a power of two
+  // and kept at most half full.
+  Vector<std::size_t> m_slots;
+  std::size_t m_mask;
+
+  std::size_t m_head; // most recently used
+  std::size_t m_tail; // least recently used
+  std::size_t m_size;
+
+  std::size_t m_capacity; // max entries, or max total weight
+  std::size_t m_weight;
+  WeightFn m_weight_fn;
+  EvictFn m_evict_fn;
+
+  Hash m_hash_fn;
+  Pred m_eq;
+
+  std::size_t m_hits;
+  std::size_t m_misses;
+  std::size_t m_evictions;
+
+public:
+  // Cache holding at most p_capacity entries
+  LruCache(std::size_t p_capacity) : LruCache(p_capacity, WeightFn()) {
+    if (p_capacity > 0)
+      m_nodes.reserve(p_capacity);
+  }
+
+  // Cache holding entries up to a total weight of p_capacity
+  LruCache(std::size_t p_capacity, WeightFn p_weight_fn)
+      : m_nodes(0), m_free(npos), m_slots(16, npos), m_mask(15), m_head(npos),
+        m_tail(npos), m_size(0), m_capacity(p_capacity), m_weight(0),
+        m_weight_fn(p_weight_fn), m_hits(0), m_misses(0), m_evictions(0) {
+    if (p_capacity == 0)
+      throw std::invalid_argument("LruCache capacity must be positive");
+  }
+
+  void set_eviction_callback(EvictFn p_fn) { m_evict_fn = p_fn; }
+
+  // Capacity
+  inline bool empty() const noexcept { return m_size == 0; }
+
+  std::size_t size() const noexcept { return m_size; }
+
+  std::size_t capacity() const noexcept { return m_capacity; }
+
+  // Total weight of the entries; the entry count without a weight function
+  std::size_t weight() const noexcept { return m_weight; }
+
+  // Statistics
+  std::size_t hits() const noexcept { return m_hits; }
+  std::size_t misses() const noexcept { return m_misses; }
+  std::size_t evictions() const noexcept { return m_evictions; }
+  void reset_stats() noexcept { m_hits = m_misses = m_evictions = 0; }
+
+  // Lookup. get() marks the entry as most recently used and counts a hit or
+  // miss; peek() does neither. Both return nullptr if the key is absent.
+  T *get(const Key &p_key) {
+    const std::size_t slot = find_slot(p_key, hash(p_key));
+    if (slot == npos) {
+      ++m_misses;
+      return nullptr;
+    }
+    ++m_hits;
+    const std::size_t idx = m_slots.data()[slot];
+    unlink(idx);
+    push_front(idx);
+    return &node(idx).m_val;
+  }
+
+  const T *peek(const Key &p_key) const {
+    const std::size_t slot = find_slot(p_key, hash(p_key));
+    return slot == npos ? nullptr : &node(m_slots.data()[slot]).m_val;
+  }
+
+  bool contains(const Key &p_key) const { return peek(p_key) != nullptr; }
+
+  // Modifiers
+  // Insert or overwrite p_key and mark it as most recently used, then evict
+  // until the cache is within capacity. The new entry itself is never
+  // evicted.
+  void put(const Key &p_key, const T &p_val) {
+    const std::size_t h = hash(p_key);
+    const std::size_t slot = find_slot(p_key, h);
+    std::size_t idx;
+    if (slot != npos) {
+      idx = m_slots.data()[slot];
+      Node &n = node(idx);
+      m_weight -= n.m_weight;
+      n.m_val = p_val;
+      n.m_weight = weigh(p_key, p_val);
+      m_weight += n.m_weight;
+      unlink(idx);
+    } else {
+      if (2 * (m_size + 1) > m_slots.size())
+        rehash(2 * m_slots.size());
+      idx = alloc_node();
+      Node &n = node(idx);
+      n.m_key = p_key;
+      n.m_val = p_val;
+      n.m_hash = h;
+      n.m_weight = weigh(p_key, p_val);
+      m_weight += n.m_weight;
+      insert_slot(idx);
+      ++m_size;
+    }
+    push_front(idx);
+
+    while (m_weight > m_capacity && m_tail != idx) {
+      const std::size_t victim = m_tail;
+      ++m_evictions;
+      if (m_evict_fn)
+        m_evict_fn(node(victim).m_key, node(victim).m_val);
+      remove(victim);
+    }
+  }
+
+  // Returns false if the key was absent. Does not call the eviction callback.
+  bool erase(const Key &p_key) {
+    const std::size_t slot = find_slot(p_key, hash(p_key));
+    if (slot == npos)
+      return false;
+    remove(m_slots.data()[slot]);
+    return true;
+  }
+
+  void clear() {
+    while (m_head != npos)
+      remove(m_head);
+  }
+
+  // Visit entries from most to least recently used
+  template <typename F> void for_each(F p_fn) const {
+    for (std::size_t i = m_head; i != npos; i = node(i).m_next)
+      p_fn(node(i).m_key, node(i).m_val);
+  }
+
+private:
+  Node &node(std::size_t p_idx) { return m_nodes.data()[p_idx]; }
+  const Node &node(std::size_t p_idx) const { return m_nodes.data()[p_idx]; }
+
+  // std::hash is the identity for integers; mix the bits so that masking
+  // with a power of two uses all of them
+  std::size_t hash(const Key &p_key) const {
+    std::uint64_t h = m_hash_fn(p_key);
+    h *= 0x9e3779b97f4a7c15ull;
+    return static_cast<std::size_t>(h ^ (h >> 32));
+  }
+
+  std::size_t weigh(const Key &p_key, const T &p_val) const {
+    return m_weight_fn ? m_weight_fn(p_key, p_val) : 1;
+  }
+
+  std::size_t find_slot(const Key &p_key, std::size_t p_hash) const {
+    const std::size_t *slots = m_slots.data();
+    for (std::size_t i = p_hash & m_mask; slots[i] != npos;
+         i = (i + 1) & m_mask) {
+      const Node &n = node(slots[i]);
+      if (n.m_hash == p_hash && m_eq(n.m_key, p_key))
+        return i;
+    }
+    return npos;
+  }
+
+  void insert_slot(std::size_t p_idx) {
+    std::size_t *slots = m_slots.data();
+    std::size_t i = node(p_idx).m_hash & m_mask;
+    while (slots[i] != npos)
+      i = (i + 1) & m_mask;
+    slots[i] = p_idx;
+  }
+
+  // Linear probing deletion: shift later entries of the probe run back so
+  // that lookups never need tombstones
+  void erase_slot(std::size_t p_slot) {
+    std::size_t *slots = m_slots.data();
+    std::size_t i = p_slot;
+    for (std::size_t j = (i + 1) & m_mask; slots[j] != npos;
+         j = (j + 1) & m_mask) {
+      const std::size_t home = node(slots[j]).m_hash & m_mask;
+      // Move slots[j] into the hole unless its home lies in (i, j]
+      const bool in_range = i <= j ? (home > i && home <= j)
+                                   : (home > i || home <= j);
+      if (!in_range) {
+        slots[i] = slots[j];
+        i = j;
+      }
+    }
+    slots[i] = npos;
+  }
+
+  void rehash(std::size_t p_slots) {
+    m_slots = Vector<std::size_t>(p_slots, npos);
+    m_mask = p_slots - 1;
+    for (std::size_t i = m_head; i != npos; i = node(i).m_next)
+      insert_slot(i);
+  }
+
+  std::size_t alloc_node() {
+    if (m_free != npos) {
+      const std::size_t idx = m_free;
+      m_free = node(idx).m_next;
+      return idx;
+    }
+    m_nodes.push_back(Node());
+    return m_nodes.size() - 1;
+  }
+
+  void remove(std::size_t p_idx) {
+    Node &n = node(p_idx);
+    erase_slot(find_slot(n.m_key, n.m_hash));
+    unlink(p_idx);
+    m_weight -= n.m_weight;
+    --m_size;
+    n.m_key = Key();
+    n.m_val = T();
+    n.m_next = m_free;
+    m_free = p_idx;
+  }
+
+  // Recency list
+  void unlink(std::size_t p_idx) {
+    Node &n = node(p_idx);
+    if (n.m_prev != npos)
+      node(n.m_prev).m_next = n.m_next;
+    else
+      m_head = n.m_next;
+    if (n.m_next != npos)
+      node(n.m_next).m_prev = n.m_prev;
+    else
+      m_tail = n.m_prev;
+  }
+
+  void push_front(std::size_t p_idx) {
+    Node &n = node(p_idx);
+    n.m_prev = npos;
+    n.m_next = m_head;
+    if (m_head != npos)
+      node(m_head).m_prev = p_idx;
+    m_head = p_idx;
+    if (m_tail == npos)
+      m_tail = p_idx;
+  }
+};
+
+template <typename Key, typename T, typename Hash, typename Pred>
+constexpr std::size_t LruCache<Key, T, Hash, Pred>::npos;
+
+} // namespace tlib
+
+#endif // TLIB_LRU_CACHE_H
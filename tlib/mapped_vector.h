@@ -0,0 +1,259 @@
+#ifndef TLIB_MAPPED_VECTOR_H
+#define TLIB_MAPPED_VECTOR_H
+
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tlib/iterator.h"
+
+namespace tlib {
+
+// Vector whose elements live in a memory-mapped file (POSIX only), for data
+// sets larger than RAM. The file is grown with ftruncate and remapped, so
+// like Vector, growing invalidates pointers and iterators. On destruction the
+// file is truncated to size() elements, so reopening the same path restores
+// the contents.
+template <typename T> class MappedVector {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "MappedVector needs a trivially copyable type");
+
+private:
+  T *m_buf; // mapped region, nullptr while capacity is 0
+  std::size_t m_size;
+  std::size_t m_cap; // elements that fit in the file
+  int m_fd;
+
+public:
+  using Iterator = SequenceIterator<T>;
+
+  // Access pattern hints, passed on to madvise
+  enum class Advice { Normal, Sequential, Random, WillNeed, DontNeed };
+
+  // Open or create the backing file. Existing contents become the elements;
+  // throws invalid_argument, leaving the file untouched, if its size is not
+  // a whole number of elements.
+  MappedVector(const char *p_path)
+      : m_buf(nullptr), m_size(0), m_cap(0), m_fd(-1) {
+    m_fd = ::open(p_path, O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0)
+      throw std::system_error(errno, std::generic_category(), "open");
+
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0) {
+      const int err = errno;
+      ::close(m_fd);
+      throw std::system_error(err, std::generic_category(), "fstat");
+    }
+    if (static_cast<std::size_t>(st.st_size) % sizeof(T) != 0) {
+      ::close(m_fd);
+      throw std::invalid_argument("File size is not a multiple of the "
+                                  "element size");
+    }
+    m_size = static_cast<std::size_t>(st.st_size) / sizeof(T);
+    if (m_size > 0) {
+      try {
+        remap(m_size);
+      } catch (...) {
+        if (m_fd >= 0)
+          ::close(m_fd);
+        throw;
+      }
+    }
+  }
+
+  // Not copyable: two objects would own the same mapping
+  MappedVector(const MappedVector &) = delete;
+  MappedVector &operator=(const MappedVector &) = delete;
+
+  // Move constructor
+  MappedVector(MappedVector &&p_move_src)
+      : m_buf(p_move_src.m_buf), m_size(p_move_src.m_size),
+        m_cap(p_move_src.m_cap), m_fd(p_move_src.m_fd) {
+    p_move_src.m_buf = nullptr;
+    p_move_src.m_size = p_move_src.m_cap = 0;
+    p_move_src.m_fd = -1;
+  }
+
+  // Move assignment
+  MappedVector &operator=(MappedVector &&p_move_src) {
+    if (this != &p_move_src) {
+      close();
+      m_buf = p_move_src.m_buf;
+      m_size = p_move_src.m_size;
+      m_cap = p_move_src.m_cap;
+      m_fd = p_move_src.m_fd;
+
+      p_move_src.m_buf = nullptr;
+      p_move_src.m_size = p_move_src.m_cap = 0;
+      p_move_src.m_fd = -1;
+    }
+    return *this;
+  }
+
+  // Destructor
+  ~MappedVector() { close(); }
+
+  // Capacity
+  inline bool empty() const noexcept { return m_size == 0; }
+
+  std::size_t size() const noexcept { return m_size; }
+
+  std::size_t capacity() const noexcept { return m_cap; }
+
+  // New elements are value-initialized
+  void resize(std::size_t p_sz) {
+    reserve(p_sz);
+    for (std::size_t i = m_size; i < p_sz; ++i)
+      m_buf[i] = T{};
+    m_size = p_sz;
+  }
+
+  void reserve(std::size_t p_sz) {
+    if (p_sz > m_cap)
+      remap(p_sz);
+  }
+
+  void shrink_to_fit() {
+    if (m_cap > m_size)
+      remap(m_size);
+  }
+
+  // Element access
+  T &operator[](std::size_t p_i) {
+    if (p_i < m_size)
+      return m_buf[p_i];
+    throw std::out_of_range("Out of range");
+  }
+  const T &operator[](std::size_t p_i) const {
+    if (p_i < m_size)
+      return m_buf[p_i];
+    throw std::out_of_range("Out of range");
+  }
+  T &at(std::size_t p_i) { return operator[](p_i); }
+  const T &at(std::size_t p_i) const { return operator[](p_i); }
+
+  T &front() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return *m_buf;
+  }
+
+  T &back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return m_buf[m_size - 1];
+  }
+
+  T *data() const { return m_buf; }
+
+  // Modifiers
+  void clear() noexcept { m_size = 0; }
+
+  void push_back(const T &el) {
+    // el may point into the mapping, which remap() unmaps
+    const T val = el;
+    if (m_size + 1 > m_cap) {
+      // Grow by at least a page to keep the number of remaps low
+      const std::size_t page = ::sysconf(_SC_PAGESIZE) / sizeof(T);
+      const std::size_t grown = m_cap * 2;
+      remap(grown > page ? grown : (page > 0 ? page : 1));
+    }
+    m_buf[m_size] = val;
+    m_size++;
+  }
+
+  void pop_back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    m_size--;
+  }
+
+  // Mapping control
+  void advise(Advice p_advice) {
+    if (!m_buf)
+      return;
+    int flag = MADV_NORMAL;
+    switch (p_advice) {
+    case Advice::Normal:
+      flag = MADV_NORMAL;
+      break;
+    case Advice::Sequential:
+      flag = MADV_SEQUENTIAL;
+      break;
+    case Advice::Random:
+      flag = MADV_RANDOM;
+      break;
+    case Advice::WillNeed:
+      flag = MADV_WILLNEED;
+      break;
+    case Advice::DontNeed:
+      flag = MADV_DONTNEED;
+      break;
+    }
+    if (::madvise(m_buf, m_cap * sizeof(T), flag) != 0)
+      throw std::system_error(errno, std::generic_category(), "madvise");
+  }
+
+  // Write dirty pages back to the file
+  void flush() {
+    if (m_buf && ::msync(m_buf, m_cap * sizeof(T), MS_SYNC) != 0)
+      throw std::system_error(errno, std::generic_category(), "msync");
+  }
+
+  // Iterator
+  Iterator begin() { return Iterator(m_buf); }
+  Iterator end() { return Iterator(m_buf + m_size); }
+
+private:
+  // Resize the file to p_cap elements and map it again. If the new mapping
+  // fails the file is trimmed back to size() elements and the object is
+  // closed.
+  void remap(std::size_t p_cap) {
+    if (::ftruncate(m_fd, p_cap * sizeof(T)) != 0)
+      throw std::system_error(errno, std::generic_category(), "ftruncate");
+    if (m_buf) {
+      ::munmap(m_buf, m_cap * sizeof(T));
+      m_buf = nullptr;
+    }
+    m_cap = p_cap;
+    if (m_cap == 0)
+      return;
+
+    void *addr = ::mmap(nullptr, m_cap * sizeof(T), PROT_READ | PROT_WRITE,
+                        MAP_SHARED, m_fd, 0);
+    if (addr == MAP_FAILED) {
+      const int err = errno;
+      (void)::ftruncate(m_fd, m_size * sizeof(T));
+      ::close(m_fd);
+      m_fd = -1;
+      m_size = m_cap = 0;
+      throw std::system_error(err, std::generic_category(), "mmap");
+    }
+    m_buf = static_cast<T *>(addr);
+  }
+
+  // Unmap, trim the file to the elements in use and close it
+  void close() noexcept {
+    if (m_fd < 0)
+      return;
+    if (m_buf)
+      ::munmap(m_buf, m_cap * sizeof(T));
+    (void)::ftruncate(m_fd, m_size * sizeof(T));
+    ::close(m_fd);
+    m_buf = nullptr;
+    m_size = m_cap = 0;
+    m_fd = -1;
+  }
+};
+
+} // namespace tlib
+
+#endif // TLIB_MAPPED_VECTOR_H
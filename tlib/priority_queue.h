@@ -0,0 +1,311 @@
+#ifndef TLIB_PRIORITY_QUEUE_H
+#define TLIB_PRIORITY_QUEUE_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "tlib/vector.h"
+
+namespace tlib {
+
+// Priority queue over a D-ary heap stored in a Vector. top() is the element
+// that compares greatest under Compare, as with std::priority_queue. With
+// D = 4 a sift-down touches a quarter as many levels as a binary heap and
+// the children of a node are adjacent, usually within one cache line.
+template <typename T, typename Compare = std::less<T>, std::size_t D = 4>
+class PriorityQueue {
+  static_assert(D >= 2, "PriorityQueue needs an arity of at least 2");
+
+private:
+  Vector<T> m_heap;
+  Compare m_comp;
+
+public:
+  static constexpr std::size_t arity = D;
+
+  // Construct/copy/destroy
+  PriorityQueue(const Compare &p_comp = Compare())
+      : m_heap(0), m_comp(p_comp) {}
+
+  // Takes the elements of p_vals and heapifies them in O(n)
+  PriorityQueue(Vector<T> p_vals, const Compare &p_comp = Compare())
+      : m_heap(std::move(p_vals)), m_comp(p_comp) {
+    make_heap();
+  }
+
+  PriorityQueue(std::initializer_list<T> p_lst,
+                const Compare &p_comp = Compare())
+      : PriorityQueue(Vector<T>(p_lst), p_comp) {}
+
+  // Capacity
+  inline bool empty() const noexcept { return m_heap.size() == 0; }
+
+  std::size_t size() const noexcept { return m_heap.size(); }
+
+  void reserve(std::size_t p_sz) { m_heap.reserve(p_sz); }
+
+  // Element access
+  const T &top() const {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return m_heap.data()[0];
+  }
+
+  // Modifiers
+  void push(const T &p_val) {
+    m_heap.push_back(p_val);
+    sift_up(size() - 1);
+  }
+
+  void pop() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    T *heap = m_heap.data();
+    const std::size_t last = size() - 1;
+    if (last > 0) {
+      heap[0] = std::move(heap[last]);
+      m_heap.pop_back();
+      sift_down(0);
+    } else {
+      m_heap.pop_back();
+    }
+  }
+
+  // Replace the contents with p_vals, heapified in O(n)
+  void heapify(Vector<T> p_vals) {
+    m_heap = std::move(p_vals);
+    make_heap();
+  }
+
+  void clear() { m_heap.resize(0); }
+
+private:
+  void make_heap() {
+    const std::size_t n = size();
+    if (n < 2)
+      return;
+    for (std::size_t i = (n - 2) / D + 1; i-- > 0;)
+      sift_down(i);
+  }
+
+  void sift_up(std::size_t p_i) {
+    T *heap = m_heap.data();
+    T val = std::move(heap[p_i]);
+    while (p_i > 0) {
+      const std::size_t parent = (p_i - 1) / D;
+      if (!m_comp(heap[parent], val))
+        break;
+      heap[p_i] = std::move(heap[parent]);
+      p_i = parent;
+    }
+    heap[p_i] = std::move(val);
+  }
+
+  void sift_down(std::size_t p_i) {
+    T *heap = m_heap.data();
+    const std::size_t n = size();
+    T val = std::move(heap[p_i]);
+    for (;;) {
+      const std::size_t first = D * p_i + 1;
+      if (first >= n)
+        break;
+      const std::size_t end = first + D < n ? first + D : n;
+      std::size_t best = first;
+      for (std::size_t c = first + 1; c < end; ++c)
+        if (m_comp(heap[best], heap[c]))
+          best = c;
+      if (!m_comp(val, heap[best]))
+        break;
+      heap[p_i] = std::move(heap[best]);
+      p_i = best;
+    }
+    heap[p_i] = std::move(val);
+  }
+};
+
+template <typename T, typename Compare, std::size_t D>
+constexpr std::size_t PriorityQueue<T, Compare, D>::arity;
+
+// PriorityQueue whose elements are addressed by handles, so that an
+// element's priority can change or the element can be removed while it is
+// queued. push() returns the handle; it stays valid until the element is
+// popped or erased, after which it may be reused.
+//
+// The heap holds handles and a position table maps each handle back to its
+// heap slot, so update(), promote() and erase() are O(D log_D n).
+template <typename T, typename Compare = std::less<T>, std::size_t D = 4>
+class IndexedPriorityQueue {
+  static_assert(D >= 2, "IndexedPriorityQueue needs an arity of at least 2");
+
+public:
+  using Handle = std::size_t;
+
+private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  Vector<Handle> m_heap;     // handles in heap order
+  Vector<T> m_vals;          // value per handle
+  Vector<std::size_t> m_pos; // heap slot per handle, npos if free
+  Vector<Handle> m_free;     // handles available for reuse
+  Compare m_comp;
+
+  bool less(Handle p_a, Handle p_b) const {
+    return m_comp(m_vals.data()[p_a], m_vals.data()[p_b]);
+  }
+
+public:
+  static constexpr std::size_t arity = D;
+
+  // Construct/copy/destroy
+  IndexedPriorityQueue(const Compare &p_comp = Compare())
+      : m_heap(0), m_vals(0), m_pos(0), m_free(0), m_comp(p_comp) {}
+
+  // Capacity
+  inline bool empty() const noexcept { return m_heap.size() == 0; }
+
+  std::size_t size() const noexcept { return m_heap.size(); }
+
+  // Element access
+  const T &top() const { return m_vals.data()[top_handle()]; }
+
+  Handle top_handle() const {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return m_heap.data()[0];
+  }
+
+  bool contains(Handle p_h) const noexcept {
+    return p_h < m_pos.size() && m_pos.data()[p_h] != npos;
+  }
+
+  const T &get(Handle p_h) const {
+    check(p_h);
+    return m_vals.data()[p_h];
+  }
+
+  // Modifiers
+  Handle push(const T &p_val) {
+    Handle h;
+    if (m_free.size() > 0) {
+      h = m_free.data()[m_free.size() - 1];
+      m_free.pop_back();
+      m_vals.data()[h] = p_val;
+    } else {
+      h = m_vals.size();
+      m_vals.push_back(p_val);
+      m_pos.push_back(npos);
+    }
+    m_heap.push_back(h);
+    m_pos.data()[h] = size() - 1;
+    sift_up(size() - 1);
+    return h;
+  }
+
+  void pop() { erase(top_handle()); }
+
+  // Remove the element behind p_h
+  void erase(Handle p_h) {
+    check(p_h);
+    const std::size_t i = m_pos.data()[p_h];
+    const std::size_t last = size() - 1;
+    m_pos.data()[p_h] = npos;
+    m_vals.data()[p_h] = T();
+    m_free.push_back(p_h);
+    if (i != last) {
+      place(i, m_heap.data()[last]);
+      m_heap.pop_back();
+      fix(i);
+    } else {
+      m_heap.pop_back();
+    }
+  }
+
+  // Set a new value for p_h, moving it up or down as needed
+  void update(Handle p_h, const T &p_val) {
+    check(p_h);
+    m_vals.data()[p_h] = p_val;
+    fix(m_pos.data()[p_h]);
+  }
+
+  // Raise the priority of p_h, i.e. move it towards the top. This is the
+  // decrease-key of a min-queue (Compare = std::greater) and an increase of
+  // the key with the default std::less. Throws invalid_argument if p_val
+  // would lower the priority; use update() for either direction.
+  void promote(Handle p_h, const T &p_val) {
+    check(p_h);
+    if (m_comp(p_val, m_vals.data()[p_h]))
+      throw std::invalid_argument("promote would lower the priority");
+    m_vals.data()[p_h] = p_val;
+    sift_up(m_pos.data()[p_h]);
+  }
+
+  void clear() {
+    m_heap.resize(0);
+    m_vals.resize(0);
+    m_pos.resize(0);
+    m_free.resize(0);
+  }
+
+private:
+  void check(Handle p_h) const {
+    if (!contains(p_h))
+      throw std::out_of_range("Invalid handle");
+  }
+
+  void place(std::size_t p_i, Handle p_h) {
+    m_heap.data()[p_i] = p_h;
+    m_pos.data()[p_h] = p_i;
+  }
+
+  void fix(std::size_t p_i) {
+    if (p_i > 0 && less(m_heap.data()[(p_i - 1) / D], m_heap.data()[p_i]))
+      sift_up(p_i);
+    else
+      sift_down(p_i);
+  }
+
+  void sift_up(std::size_t p_i) {
+    const Handle h = m_heap.data()[p_i];
+    while (p_i > 0) {
+      const std::size_t parent = (p_i - 1) / D;
+      if (!less(m_heap.data()[parent], h))
+        break;
+      place(p_i, m_heap.data()[parent]);
+      p_i = parent;
+    }
+    place(p_i, h);
+  }
+
+  void sift_down(std::size_t p_i) {
+    const Handle *heap = m_heap.data();
+    const std::size_t n = size();
+    const Handle h = heap[p_i];
+    for (;;) {
+      const std::size_t first = D * p_i + 1;
+      if (first >= n)
+        break;
+      const std::size_t end = first + D < n ? first + D : n;
+      std::size_t best = first;
+      for (std::size_t c = first + 1; c < end; ++c)
+        if (less(heap[best], heap[c]))
+          best = c;
+      if (!less(h, heap[best]))
+        break;
+      place(p_i, heap[best]);
+      p_i = best;
+    }
+    place(p_i, h);
+  }
+};
+
+template <typename T, typename Compare, std::size_t D>
+constexpr std::size_t IndexedPriorityQueue<T, Compare, D>::npos;
+template <typename T, typename Compare, std::size_t D>
+constexpr std::size_t IndexedPriorityQueue<T, Compare, D>::arity;
+
+} // namespace tlib
+
+#endif // TLIB_PRIORITY_QUEUE_H
@@ -0,0 +1,232 @@
+#ifndef TLIB_RING_BUFFER_H
+#define TLIB_RING_BUFFER_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace tlib {
+
+// Fixed-capacity circular buffer. Storage is allocated once at construction;
+// push/pop at both ends never allocate and throw when the buffer is full or
+// empty.
+template <typename T> class RingBuffer {
+public:
+  struct RingIterator {
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+
+    RingIterator(RingBuffer *p_rb, std::size_t p_idx)
+        : m_rb(p_rb), m_idx(p_idx){};
+
+    reference operator*() const { return m_rb->elem(m_idx); }
+    pointer operator->() const { return &operator*(); }
+    reference operator[](difference_type p_n) const {
+      return m_rb->elem(m_idx + p_n);
+    }
+
+    RingIterator &operator++() {
+      m_idx++;
+      return *this;
+    }
+    RingIterator operator++(int) {
+      RingIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    RingIterator &operator--() {
+      m_idx--;
+      return *this;
+    }
+    RingIterator operator--(int) {
+      RingIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    RingIterator &operator+=(difference_type p_n) {
+      m_idx += p_n;
+      return *this;
+    }
+    RingIterator &operator-=(difference_type p_n) {
+      m_idx -= p_n;
+      return *this;
+    }
+    friend RingIterator operator+(RingIterator x, difference_type p_n) {
+      return x += p_n;
+    }
+    friend RingIterator operator-(RingIterator x, difference_type p_n) {
+      return x -= p_n;
+    }
+    friend difference_type operator-(const RingIterator x,
+                                     const RingIterator y) {
+      return static_cast<difference_type>(x.m_idx) -
+             static_cast<difference_type>(y.m_idx);
+    }
+
+    friend bool operator==(const RingIterator x, const RingIterator y) {
+      return x.m_idx == y.m_idx;
+    }
+    friend bool operator!=(const RingIterator x, const RingIterator y) {
+      return x.m_idx != y.m_idx;
+    }
+    friend bool operator>(const RingIterator x, const RingIterator y) {
+      return x.m_idx > y.m_idx;
+    }
+    friend bool operator>=(const RingIterator x, const RingIterator y) {
+      return x.m_idx >= y.m_idx;
+    }
+    friend bool operator<(const RingIterator x, const RingIterator y) {
+      return x.m_idx < y.m_idx;
+    }
+    friend bool operator<=(const RingIterator x, const RingIterator y) {
+      return x.m_idx <= y.m_idx;
+    }
+
+  private:
+    RingBuffer *m_rb;
+    std::size_t m_idx; // logical index, 0 is the front
+  };
+
+  using Iterator = RingIterator;
+
+private:
+  T *m_buf;
+  std::size_t m_cap;
+  std::size_t m_head; // physical index of the front element
+  std::size_t m_size;
+
+public:
+  // Construct/copy/destroy
+  RingBuffer(std::size_t p_cap)
+      : m_buf(new T[p_cap]), m_cap(p_cap), m_head(0), m_size(0) {}
+
+  // Copy constructor
+  RingBuffer(const RingBuffer &p_copy_src) : RingBuffer(p_copy_src.m_cap) {
+    for (std::size_t i = 0; i < p_copy_src.size(); ++i)
+      push_back(p_copy_src[i]);
+  }
+
+  // Copy assignment
+  RingBuffer &operator=(const RingBuffer &p_copy_src) {
+    if (this != &p_copy_src) {
+      delete[] m_buf;
+      m_buf = new T[p_copy_src.m_cap];
+      m_cap = p_copy_src.m_cap;
+      m_head = m_size = 0;
+      for (std::size_t i = 0; i < p_copy_src.size(); ++i)
+        push_back(p_copy_src[i]);
+    }
+    return *this;
+  }
+
+  // Move constructor
+  RingBuffer(RingBuffer &&p_move_src)
+      : m_buf(p_move_src.m_buf), m_cap(p_move_src.m_cap),
+        m_head(p_move_src.m_head), m_size(p_move_src.m_size) {
+    p_move_src.m_buf = nullptr;
+    p_move_src.m_cap = p_move_src.m_head = p_move_src.m_size = 0;
+  }
+
+  // Move assignment
+  RingBuffer &operator=(RingBuffer &&p_move_src) {
+    if (this != &p_move_src) {
+      delete[] m_buf;
+      m_buf = p_move_src.m_buf;
+      m_cap = p_move_src.m_cap;
+      m_head = p_move_src.m_head;
+      m_size = p_move_src.m_size;
+
+      p_move_src.m_buf = nullptr;
+      p_move_src.m_cap = p_move_src.m_head = p_move_src.m_size = 0;
+    }
+    return *this;
+  }
+
+  // Destructor
+  ~RingBuffer() { delete[] m_buf; }
+
+  // Capacity
+  inline bool empty() const noexcept { return m_size == 0; }
+  inline bool full() const noexcept { return m_size == m_cap; }
+
+  std::size_t size() const noexcept { return m_size; }
+
+  std::size_t capacity() const noexcept { return m_cap; }
+
+  // Element access
+  T &operator[](std::size_t p_i) {
+    if (p_i < m_size)
+      return elem(p_i);
+    throw std::out_of_range("Out of range");
+  }
+  const T &operator[](std::size_t p_i) const {
+    if (p_i < m_size)
+      return elem(p_i);
+    throw std::out_of_range("Out of range");
+  }
+  T &at(std::size_t p_i) { return operator[](p_i); }
+  const T &at(std::size_t p_i) const { return operator[](p_i); }
+
+  T &front() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return elem(0);
+  }
+
+  T &back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return elem(m_size - 1);
+  }
+
+  // Modifiers
+  void clear() noexcept { m_head = m_size = 0; }
+
+  void push_back(const T &p_val) {
+    if (full())
+      throw std::out_of_range("Full");
+    elem(m_size) = p_val;
+    ++m_size;
+  }
+
+  void pop_back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    --m_size;
+  }
+
+  void push_front(const T &p_val) {
+    if (full())
+      throw std::out_of_range("Full");
+    m_head = m_head == 0 ? m_cap - 1 : m_head - 1;
+    m_buf[m_head] = p_val;
+    ++m_size;
+  }
+
+  void pop_front() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    m_head = wrap(m_head + 1);
+    --m_size;
+  }
+
+  // Iterator
+  Iterator begin() { return Iterator(this, 0); }
+  Iterator end() { return Iterator(this, m_size); }
+
+private:
+  // Indices never exceed 2 * capacity, so a compare replaces the modulo
+  std::size_t wrap(std::size_t p_i) const noexcept {
+    return p_i >= m_cap ? p_i - m_cap : p_i;
+  }
+
+  T &elem(std::size_t p_i) const { return m_buf[wrap(m_head + p_i)]; }
+};
+
+} // namespace tlib
+
+#endif // TLIB_RING_BUFFER_H
@@ -0,0 +1,415 @@
+#ifndef TLIB_SERIALIZE_H
+#define TLIB_SERIALIZE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "tlib/list.h"
+#include "tlib/string.h"
+#include "tlib/vector.h"
+
+// Default chunk size of the writer and reader buffers
+#define _SERIAL_CHUNK 4096
+
+namespace tlib {
+
+// Binary format, host byte order:
+//   trivially copyable T   sizeof(T) raw bytes
+//   String                 u64 length, then the characters (no terminator)
+//   Vector<T>, List<T>     u64 count, then the elements. Arrays of trivially
+//                          copyable T are padded to alignof(T) (counted from
+//                          the start of the stream) and copied in bulk, so a
+//                          reader over an aligned buffer can view them in
+//                          place.
+
+// Buffers output in fixed-size chunks and hands full chunks to a sink, so a
+// payload never has to be materialized as a whole. Writes larger than a
+// chunk bypass the buffer.
+class BinaryWriter {
+public:
+  using Sink = std::function<void(const char *, std::size_t)>;
+
+private:
+  Sink m_sink;
+  Vector<char> m_chunk;
+  std::size_t m_used;   // bytes buffered in m_chunk
+  std::size_t m_offset; // bytes written since the start of the stream
+
+public:
+  BinaryWriter(Sink p_sink, std::size_t p_chunk = _SERIAL_CHUNK)
+      : m_sink(p_sink), m_chunk(p_chunk), m_used(0), m_offset(0) {}
+
+  BinaryWriter(const BinaryWriter &) = delete;
+  BinaryWriter &operator=(const BinaryWriter &) = delete;
+
+  // Flushes what is left. Errors from the sink are dropped here; call
+  // flush() explicitly to see them.
+  ~BinaryWriter() {
+    try {
+      flush();
+    } catch (...) {
+    }
+  }
+
+  std::size_t offset() const noexcept { return m_offset; }
+
+  void write_bytes(const void *p_src, std::size_t p_n) {
+    if (p_n == 0)
+      return;
+    const char *src = static_cast<const char *>(p_src);
+    m_offset += p_n;
+    if (m_used + p_n <= m_chunk.size()) {
+      std::memcpy(m_chunk.data() + m_used, src, p_n);
+      m_used += p_n;
+      return;
+    }
+    flush();
+    if (p_n >= m_chunk.size()) {
+      m_sink(src, p_n);
+    } else {
+      std::memcpy(m_chunk.data(), src, p_n);
+      m_used = p_n;
+    }
+  }
+
+  template <typename T> void write(const T &p_val) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "write() needs a trivially copyable type");
+    write_bytes(&p_val, sizeof(T));
+  }
+
+  // Zero-pad to a multiple of p_align from the start of the stream
+  void align(std::size_t p_align) {
+    static const char zeros[64] = {};
+    std::size_t pad = (p_align - m_offset % p_align) % p_align;
+    while (pad) {
+      const std::size_t n = pad < sizeof(zeros) ? pad : sizeof(zeros);
+      write_bytes(zeros, n);
+      pad -= n;
+    }
+  }
+
+  void flush() {
+    if (m_used) {
+      m_sink(m_chunk.data(), m_used);
+      m_used = 0;
+    }
+  }
+};
+
+// Sink appending to a Vector<char>
+inline BinaryWriter::Sink vector_sink(Vector<char> &p_out) {
+  return [&p_out](const char *p_src, std::size_t p_n) {
+    const std::size_t need = p_out.size() + p_n;
+    if (need > p_out.capacity())
+      p_out.reserve(need > 2 * p_out.capacity() ? need : 2 * p_out.capacity());
+    char *dst = p_out.data() + p_out.size();
+    p_out.resize(p_out.size() + p_n);
+    std::memcpy(dst, p_src, p_n);
+  };
+}
+
+// Non-owning view of n contiguous elements
+template <typename T> struct ArrayView {
+  const T *m_data;
+  std::size_t m_size;
+
+  const T *data() const noexcept { return m_data; }
+  std::size_t size() const noexcept { return m_size; }
+  inline bool empty() const noexcept { return m_size == 0; }
+  const T &operator[](std::size_t p_i) const {
+    if (p_i < m_size)
+      return m_data[p_i];
+    throw std::out_of_range("Out of range");
+  }
+  const T *begin() const noexcept { return m_data; }
+  const T *end() const noexcept { return m_data + m_size; }
+};
+
+// Reads either from a source callback, refilling an internal buffer one
+// chunk at a time, or directly from a buffer in memory. Only the in-memory
+// mode supports views.
+class BinaryReader {
+public:
+  // Fills up to n bytes and returns how many were read, 0 at end of input
+  using Source = std::function<std::size_t(char *, std::size_t)>;
+
+private:
+  Source m_source;
+  Vector<char> m_chunk;
+  const char *m_pos;
+  const char *m_end;
+  std::size_t m_offset; // bytes consumed since the start of the stream
+
+public:
+  BinaryReader(Source p_source, std::size_t p_chunk = _SERIAL_CHUNK)
+      : m_source(p_source), m_chunk(p_chunk), m_pos(nullptr), m_end(nullptr),
+        m_offset(0) {}
+
+  BinaryReader(const char *p_buf, std::size_t p_len)
+      : m_chunk(0), m_pos(p_buf), m_end(p_buf + p_len), m_offset(0) {}
+
+  BinaryReader(const BinaryReader &) = delete;
+  BinaryReader &operator=(const BinaryReader &) = delete;
+
+  bool in_memory() const noexcept { return !m_source; }
+
+  // Bytes left in the input buffer. Only meaningful for in-memory readers.
+  std::size_t remaining() const noexcept { return m_end - m_pos; }
+
+  std::size_t offset() const noexcept { return m_offset; }
+
+  void read_bytes(void *p_dst, std::size_t p_n) {
+    char *dst = static_cast<char *>(p_dst);
+    while (p_n) {
+      std::size_t avail = m_end - m_pos;
+      if (avail == 0) {
+        // Large reads go straight to the destination
+        if (m_source && p_n >= m_chunk.size()) {
+          const std::size_t got = m_source(dst, p_n);
+          if (got == 0)
+            throw std::runtime_error("Unexpected end of input");
+          dst += got;
+          p_n -= got;
+          m_offset += got;
+          continue;
+        }
+        avail = refill();
+      }
+      const std::size_t n = avail < p_n ? avail : p_n;
+      std::memcpy(dst, m_pos, n);
+      m_pos += n;
+      dst += n;
+      p_n -= n;
+      m_offset += n;
+    }
+  }
+
+  template <typename T> T read() {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "read() needs a trivially copyable type");
+    T val;
+    read_bytes(&val, sizeof(T));
+    return val;
+  }
+
+  // Skip the padding written by BinaryWriter::align()
+  void align(std::size_t p_align) {
+    char buf[64];
+    std::size_t pad = (p_align - m_offset % p_align) % p_align;
+    while (pad) {
+      const std::size_t n = pad < sizeof(buf) ? pad : sizeof(buf);
+      read_bytes(buf, n);
+      pad -= n;
+    }
+  }
+
+  // Pointer to the next p_n bytes of the input buffer, without copying
+  const char *view_bytes(std::size_t p_n) {
+    if (!in_memory())
+      throw std::logic_error("Views need an in-memory reader");
+    if (static_cast<std::size_t>(m_end - m_pos) < p_n)
+      throw std::runtime_error("Unexpected end of input");
+    const char *res = m_pos;
+    m_pos += p_n;
+    m_offset += p_n;
+    return res;
+  }
+
+private:
+  std::size_t refill() {
+    if (!m_source)
+      throw std::runtime_error("Unexpected end of input");
+    const std::size_t got = m_source(m_chunk.data(), m_chunk.size());
+    if (got == 0)
+      throw std::runtime_error("Unexpected end of input");
+    m_pos = m_chunk.data();
+    m_end = m_pos + got;
+    return got;
+  }
+};
+
+// Serialization
+template <typename T>
+typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+serialize(BinaryWriter &p_out, const T &p_val) {
+  p_out.write(p_val);
+}
+
+inline void serialize(BinaryWriter &p_out, const String &p_str) {
+  const std::uint64_t n = p_str.size();
+  p_out.write(n);
+  p_out.write_bytes(p_str.c_str(), n);
+}
+
+template <typename T>
+void serialize(BinaryWriter &p_out, const Vector<T> &p_vec);
+template <typename T> void serialize(BinaryWriter &p_out, const List<T> &p_lst);
+
+namespace serial_detail {
+template <typename T>
+void write_array(BinaryWriter &p_out, const T *p_src, std::size_t p_n,
+                 std::true_type) {
+  p_out.align(alignof(T));
+  p_out.write_bytes(p_src, p_n * sizeof(T));
+}
+template <typename T>
+void write_array(BinaryWriter &p_out, const T *p_src, std::size_t p_n,
+                 std::false_type) {
+  for (std::size_t i = 0; i < p_n; ++i)
+    serialize(p_out, p_src[i]);
+}
+} // namespace serial_detail
+
+template <typename T>
+void serialize(BinaryWriter &p_out, const Vector<T> &p_vec) {
+  p_out.write(static_cast<std::uint64_t>(p_vec.size()));
+  serial_detail::write_array(p_out, p_vec.data(), p_vec.size(),
+                             std::is_trivially_copyable<T>{});
+}
+
+template <typename T>
+void serialize(BinaryWriter &p_out, const List<T> &p_lst) {
+  p_out.write(static_cast<std::uint64_t>(p_lst.size()));
+  for (const auto &v : p_lst)
+    serialize(p_out, v);
+}
+
+// Deserialization
+//
+// Length prefixes are not trusted. An in-memory reader rejects a count
+// that the remaining input cannot hold. A streaming reader grows its output
+// one chunk at a time as the payload arrives, so a corrupt prefix fails at
+// the end of input instead of allocating what it claims up front.
+
+namespace serial_detail {
+// Throw unless p_n elements of at least p_min_bytes each can still be in
+// the input. Every serialized value takes at least one byte.
+inline void check_count(const BinaryReader &p_in, std::uint64_t p_n,
+                        std::size_t p_min_bytes) {
+  if (p_in.in_memory() && p_n > p_in.remaining() / p_min_bytes)
+    throw std::runtime_error("Length exceeds input");
+}
+
+// Elements to read per step from a streaming reader
+template <typename T> std::size_t chunk_elems() {
+  return sizeof(T) < _SERIAL_CHUNK ? _SERIAL_CHUNK / sizeof(T) : 1;
+}
+} // namespace serial_detail
+
+template <typename T>
+typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+deserialize(BinaryReader &p_in, T &p_val) {
+  p_in.read_bytes(&p_val, sizeof(T));
+}
+
+inline void deserialize(BinaryReader &p_in, String &p_str) {
+  const std::uint64_t n = p_in.read<std::uint64_t>();
+  serial_detail::check_count(p_in, n, 1);
+  if (p_in.in_memory()) {
+    String res(n, '\0');
+    p_in.read_bytes(res.data(), n);
+    p_str = std::move(res);
+    return;
+  }
+  Vector<char> buf(0);
+  for (std::size_t got = 0; got < n;) {
+    const std::size_t step =
+        n - got < _SERIAL_CHUNK ? n - got : _SERIAL_CHUNK;
+    buf.grow(got + step);
+    p_in.read_bytes(buf.data() + got, step);
+    got += step;
+  }
+  String res(n, '\0');
+  if (n)
+    std::memcpy(res.data(), buf.data(), n);
+  p_str = std::move(res);
+}
+
+template <typename T> void deserialize(BinaryReader &p_in, Vector<T> &p_vec);
+template <typename T> void deserialize(BinaryReader &p_in, List<T> &p_lst);
+
+namespace serial_detail {
+template <typename T>
+void read_array(BinaryReader &p_in, T *p_dst, std::size_t p_n,
+                std::true_type) {
+  p_in.align(alignof(T));
+  p_in.read_bytes(p_dst, p_n * sizeof(T));
+}
+template <typename T>
+void read_array(BinaryReader &p_in, T *p_dst, std::size_t p_n,
+                std::false_type) {
+  for (std::size_t i = 0; i < p_n; ++i)
+    deserialize(p_in, p_dst[i]);
+}
+} // namespace serial_detail
+
+template <typename T> void deserialize(BinaryReader &p_in, Vector<T> &p_vec) {
+  using bulk = std::is_trivially_copyable<T>;
+  const std::uint64_t n = p_in.read<std::uint64_t>();
+  serial_detail::check_count(p_in, n, bulk::value ? sizeof(T) : 1);
+  if (p_in.in_memory()) {
+    p_vec.resize(n);
+    serial_detail::read_array(p_in, p_vec.data(), n, bulk{});
+    return;
+  }
+  if (bulk::value)
+    p_in.align(alignof(T));
+  p_vec.resize(0);
+  const std::size_t chunk = serial_detail::chunk_elems<T>();
+  for (std::size_t got = 0; got < n;) {
+    const std::size_t step = n - got < chunk ? n - got : chunk;
+    p_vec.grow(got + step);
+    if (bulk::value)
+      p_in.read_bytes(p_vec.data() + got, step * sizeof(T));
+    else
+      serial_detail::read_array(p_in, p_vec.data() + got, step,
+                                std::false_type{});
+    got += step;
+  }
+}
+
+template <typename T> void deserialize(BinaryReader &p_in, List<T> &p_lst) {
+  const std::uint64_t n = p_in.read<std::uint64_t>();
+  serial_detail::check_count(p_in, n, 1);
+  p_lst.erase();
+  for (std::uint64_t i = 0; i < n; ++i) {
+    T val;
+    deserialize(p_in, val);
+    p_lst.push_back(val);
+  }
+}
+
+// In-place views over an in-memory reader. The views point into the input
+// buffer and are valid as long as it is.
+inline ArrayView<char> view_string(BinaryReader &p_in) {
+  if (!p_in.in_memory())
+    throw std::logic_error("Views need an in-memory reader");
+  const std::uint64_t n = p_in.read<std::uint64_t>();
+  serial_detail::check_count(p_in, n, 1);
+  return ArrayView<char>{p_in.view_bytes(n), n};
+}
+
+// View of a serialized Vector<T>. Throws if the input buffer is not aligned
+// for T.
+template <typename T> ArrayView<T> view_vector(BinaryReader &p_in) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Only arrays of trivially copyable types can be viewed");
+  if (!p_in.in_memory())
+    throw std::logic_error("Views need an in-memory reader");
+  const std::uint64_t n = p_in.read<std::uint64_t>();
+  serial_detail::check_count(p_in, n, sizeof(T));
+  p_in.align(alignof(T));
+  const char *bytes = p_in.view_bytes(n * sizeof(T));
+  if (reinterpret_cast<std::uintptr_t>(bytes) % alignof(T))
+    throw std::runtime_error("Misaligned input buffer");
+  return ArrayView<T>{reinterpret_cast<const T *>(bytes), n};
+}
+
+} // namespace tlib
+
+#endif // TLIB_SERIALIZE_H
@@ -0,0 +1,243 @@
+#ifndef TLIB_SHARED_VECTOR_H
+#define TLIB_SHARED_VECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "tlib/vector.h"
+
+namespace tlib {
+
+template <typename T> class AtomicSharedVector;
+
+// Immutable snapshot of a Vector with an atomic reference count. Copies are
+// O(1) and share the elements; the mutating members copy the elements first
+// if the snapshot is shared (copy-on-write), so other holders never see a
+// change.
+template <typename T> class SharedVector {
+  friend class AtomicSharedVector<T>;
+
+private:
+  struct Rep {
+    std::atomic<std::size_t> m_refs;
+    Vector<T> m_vec;
+
+    Rep(Vector<T> &&p_vec) : m_refs(1), m_vec(std::move(p_vec)) {}
+    Rep(const Vector<T> &p_vec) : m_refs(1), m_vec(p_vec) {}
+  };
+
+  Rep *m_rep; // nullptr for an empty snapshot
+
+  explicit SharedVector(Rep *p_rep) : m_rep(p_rep) {}
+
+  static void retain(Rep *p_rep) noexcept {
+    if (p_rep)
+      p_rep->m_refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  static void release(Rep *p_rep) noexcept {
+    if (p_rep && p_rep->m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete p_rep;
+  }
+
+public:
+  using ConstIterator = const T *;
+
+  // Construct/copy/destroy
+  SharedVector() : m_rep(nullptr) {}
+
+  SharedVector(Vector<T> &&p_vec) : m_rep(new Rep(std::move(p_vec))) {}
+  SharedVector(const Vector<T> &p_vec) : m_rep(new Rep(p_vec)) {}
+  SharedVector(std::initializer_list<T> p_lst)
+      : m_rep(new Rep(Vector<T>(p_lst))) {}
+
+  // Copy constructor, shares the elements
+  SharedVector(const SharedVector &p_copy_src) : m_rep(p_copy_src.m_rep) {
+    retain(m_rep);
+  }
+
+  // Copy assignment, shares the elements
+  SharedVector &operator=(const SharedVector &p_copy_src) {
+    retain(p_copy_src.m_rep);
+    release(m_rep);
+    m_rep = p_copy_src.m_rep;
+    return *this;
+  }
+
+  // Move constructor
+  SharedVector(SharedVector &&p_move_src) : m_rep(p_move_src.m_rep) {
+    p_move_src.m_rep = nullptr;
+  }
+
+  // Move assignment
+  SharedVector &operator=(SharedVector &&p_move_src) {
+    if (this != &p_move_src) {
+      release(m_rep);
+      m_rep = p_move_src.m_rep;
+      p_move_src.m_rep = nullptr;
+    }
+    return *this;
+  }
+
+  // Destructor
+  ~SharedVector() { release(m_rep); }
+
+  // Capacity
+  inline bool empty() const noexcept { return size() == 0; }
+
+  std::size_t size() const noexcept { return m_rep ? m_rep->m_vec.size() : 0; }
+
+  // Number of snapshots sharing these elements
+  std::size_t use_count() const noexcept {
+    return m_rep ? m_rep->m_refs.load(std::memory_order_relaxed) : 0;
+  }
+
+  // Element access
+  const T &operator[](std::size_t p_i) const {
+    if (p_i < size())
+      return m_rep->m_vec.data()[p_i];
+    throw std::out_of_range("Out of range");
+  }
+  const T &at(std::size_t p_i) const { return operator[](p_i); }
+
+  const T &front() const {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return m_rep->m_vec.data()[0];
+  }
+
+  const T &back() const {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return m_rep->m_vec.data()[size() - 1];
+  }
+
+  const T *data() const noexcept {
+    return m_rep ? m_rep->m_vec.data() : nullptr;
+  }
+
+  // Copy-on-write. Returns the underlying Vector after making sure no other
+  // snapshot shares it. The reference is valid until this snapshot is next
+  // copied.
+  Vector<T> &edit() {
+    if (!m_rep) {
+      m_rep = new Rep(Vector<T>(0));
+    } else if (m_rep->m_refs.load(std::memory_order_acquire) != 1) {
+      Rep *own = new Rep(m_rep->m_vec);
+      release(m_rep);
+      m_rep = own;
+    }
+    return m_rep->m_vec;
+  }
+
+  // Modifiers, copy-on-write
+  void set(std::size_t p_i, const T &p_val) { edit()[p_i] = p_val; }
+
+  void push_back(const T &p_val) { edit().push_back(p_val); }
+
+  void pop_back() { edit().pop_back(); }
+
+  // Iterator
+  ConstIterator begin() const noexcept { return data(); }
+  ConstIterator end() const noexcept { return data() + size(); }
+};
+
+// Holder of the current SharedVector snapshot that threads can publish and
+// acquire concurrently, e.g. a routing table swapped by one writer and read
+// by many threads. Building a new snapshot happens outside the holder.
+//
+// Nothing blocks: acquire() and publish() are a few atomic operations on
+// one word. A reader's compare-and-swap only retries when another thread
+// changed the word, so a preempted thread never holds up the others. The
+// word packs the snapshot pointer (low 48 bits, which is enough for
+// user-space addresses on x86-64 and AArch64) with a count of acquires in
+// flight (high 16 bits, so at most 65535 at once). That count is split
+// from the snapshot's own reference count:
+//   acquire()   bumps the in-flight count, which keeps the snapshot alive,
+//               takes a real reference, then gives the in-flight count
+//               back if the word still holds the same snapshot.
+//   exchange()  swaps the word and moves the in-flight count it took out
+//               into the old snapshot's reference count, so the readers
+//               that could not give theirs back drop it there instead.
+template <typename T> class AtomicSharedVector {
+  static_assert(sizeof(void *) == 8,
+                "AtomicSharedVector packs a pointer into 48 bits");
+
+private:
+  using Rep = typename SharedVector<T>::Rep;
+
+  static constexpr std::uint64_t count_one = std::uint64_t(1) << 48;
+  static constexpr std::uint64_t ptr_mask = count_one - 1;
+
+  mutable std::atomic<std::uint64_t> m_word;
+
+  static Rep *rep_of(std::uint64_t p_word) noexcept {
+    return reinterpret_cast<Rep *>(static_cast<std::uintptr_t>(
+        p_word & ptr_mask));
+  }
+  static std::uint64_t pack(Rep *p_rep) {
+    const std::uint64_t w = reinterpret_cast<std::uintptr_t>(p_rep);
+    if (w & ~ptr_mask)
+      throw std::runtime_error("Snapshot address does not fit in 48 bits");
+    return w;
+  }
+
+public:
+  AtomicSharedVector() : m_word(0) {}
+
+  AtomicSharedVector(SharedVector<T> p_init) : m_word(pack(p_init.m_rep)) {
+    p_init.m_rep = nullptr;
+  }
+
+  AtomicSharedVector(const AtomicSharedVector &) = delete;
+  AtomicSharedVector &operator=(const AtomicSharedVector &) = delete;
+
+  ~AtomicSharedVector() {
+    SharedVector<T>::release(rep_of(m_word.load(std::memory_order_acquire)));
+  }
+
+  // Current snapshot. The caller keeps it alive regardless of later publishes.
+  SharedVector<T> acquire() const {
+    std::uint64_t cur = m_word.fetch_add(count_one, std::memory_order_acq_rel);
+    Rep *rep = rep_of(cur);
+    SharedVector<T>::retain(rep);
+    cur += count_one;
+    // Give the in-flight count back while the word still holds our
+    // snapshot. A zero count means a writer already moved ours into the
+    // snapshot's reference count, even if the same snapshot was published
+    // again since.
+    while (rep_of(cur) == rep && (cur & ~ptr_mask) != 0) {
+      if (m_word.compare_exchange_weak(cur, cur - count_one,
+                                       std::memory_order_acq_rel))
+        return SharedVector<T>(rep);
+    }
+    SharedVector<T>::release(rep);
+    return SharedVector<T>(rep);
+  }
+
+  // Make p_next the current snapshot
+  void publish(SharedVector<T> p_next) { exchange(std::move(p_next)); }
+
+  // Make p_next the current snapshot and return the previous one
+  SharedVector<T> exchange(SharedVector<T> p_next) {
+    const std::uint64_t next = pack(p_next.m_rep);
+    p_next.m_rep = nullptr;
+    const std::uint64_t prev = m_word.exchange(next, std::memory_order_acq_rel);
+    Rep *rep = rep_of(prev);
+    if (rep && (prev >> 48))
+      rep->m_refs.fetch_add(prev >> 48, std::memory_order_relaxed);
+    return SharedVector<T>(rep);
+  }
+};
+
+template <typename T>
+constexpr std::uint64_t AtomicSharedVector<T>::count_one;
+template <typename T>
+constexpr std::uint64_t AtomicSharedVector<T>::ptr_mask;
+
+} // namespace tlib
+
+#endif // TLIB_SHARED_VECTOR_H
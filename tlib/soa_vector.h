@@ -0,0 +1,252 @@
+#ifndef TLIB_SOA_VECTOR_H
+#define TLIB_SOA_VECTOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "tlib/vector.h"
+
+namespace tlib {
+
+// Structure-of-arrays container. Each field of a record is stored in its own
+// contiguous tlib::Vector column, so a loop over one field only streams that
+// field through the cache.
+template <typename... Fields> class SoAVector {
+  static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+public:
+  using value_type = std::tuple<Fields...>;
+  template <std::size_t I>
+  using field_type = typename std::tuple_element<I, value_type>::type;
+  template <std::size_t I> using column_type = Vector<field_type<I>>;
+
+  // Proxy for one row. Reads and writes go straight to the columns.
+  struct Row {
+    Row(SoAVector *p_soa, std::size_t p_idx) : m_soa(p_soa), m_idx(p_idx){};
+    Row(const Row &) = default;
+
+    template <std::size_t I> field_type<I> &get() const {
+      return m_soa->template data<I>()[m_idx];
+    }
+
+    // Assign all fields from a tuple
+    Row &operator=(const value_type &p_val) {
+      m_soa->assign(m_idx, p_val, std::index_sequence_for<Fields...>{});
+      return *this;
+    }
+
+    // Copy the fields of another row, not the proxy itself
+    Row &operator=(const Row &p_other) {
+      return *this = static_cast<value_type>(p_other);
+    }
+
+    // Gather the fields back into a tuple
+    operator value_type() const {
+      return m_soa->gather(m_idx, std::index_sequence_for<Fields...>{});
+    }
+
+  private:
+    SoAVector *m_soa;
+    std::size_t m_idx;
+  };
+
+  struct RowIterator {
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename SoAVector::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = Row;
+    using pointer = void;
+
+    RowIterator(SoAVector *p_soa, std::size_t p_idx)
+        : m_soa(p_soa), m_idx(p_idx){};
+
+    reference operator*() const { return Row(m_soa, m_idx); }
+    reference operator[](difference_type p_n) const {
+      return Row(m_soa, m_idx + p_n);
+    }
+
+    RowIterator &operator++() {
+      ++m_idx;
+      return *this;
+    }
+    RowIterator operator++(int) {
+      RowIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    RowIterator &operator--() {
+      --m_idx;
+      return *this;
+    }
+    RowIterator operator--(int) {
+      RowIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    RowIterator &operator+=(difference_type p_n) {
+      m_idx += p_n;
+      return *this;
+    }
+    RowIterator &operator-=(difference_type p_n) {
+      m_idx -= p_n;
+      return *this;
+    }
+    friend RowIterator operator+(RowIterator x, difference_type p_n) {
+      return x += p_n;
+    }
+    friend RowIterator operator-(RowIterator x, difference_type p_n) {
+      return x -= p_n;
+    }
+    friend difference_type operator-(const RowIterator x,
+                                     const RowIterator y) {
+      return static_cast<difference_type>(x.m_idx) -
+             static_cast<difference_type>(y.m_idx);
+    }
+
+    friend bool operator==(const RowIterator x, const RowIterator y) {
+      return x.m_idx == y.m_idx;
+    }
+    friend bool operator!=(const RowIterator x, const RowIterator y) {
+      return x.m_idx != y.m_idx;
+    }
+    friend bool operator<(const RowIterator x, const RowIterator y) {
+      return x.m_idx < y.m_idx;
+    }
+    friend bool operator>(const RowIterator x, const RowIterator y) {
+      return x.m_idx > y.m_idx;
+    }
+    friend bool operator<=(const RowIterator x, const RowIterator y) {
+      return x.m_idx <= y.m_idx;
+    }
+    friend bool operator>=(const RowIterator x, const RowIterator y) {
+      return x.m_idx >= y.m_idx;
+    }
+
+  private:
+    SoAVector *m_soa;
+    std::size_t m_idx;
+  };
+
+  using Iterator = RowIterator;
+
+private:
+  std::tuple<Vector<Fields>...> m_cols;
+
+public:
+  // Construct/copy/destroy. Columns own their storage, so copy, move and
+  // destruction are the defaults.
+  SoAVector() : m_cols(Vector<Fields>(0)...) {}
+
+  SoAVector(std::size_t p_sz) : m_cols(Vector<Fields>(p_sz)...) {}
+
+  // Capacity
+  inline bool empty() const noexcept { return size() == 0; }
+
+  std::size_t size() const noexcept { return std::get<0>(m_cols).size(); }
+
+  std::size_t capacity() const noexcept {
+    return std::get<0>(m_cols).capacity();
+  }
+
+  void resize(std::size_t p_sz) {
+    for_each_column([p_sz](auto &col) { col.resize(p_sz); });
+  }
+
+  void reserve(std::size_t p_sz) {
+    for_each_column([p_sz](auto &col) { col.reserve(p_sz); });
+  }
+
+  // Column access. A column is a plain tlib::Vector, so data()/size() give a
+  // contiguous span of one field.
+  template <std::size_t I> column_type<I> &column() {
+    return std::get<I>(m_cols);
+  }
+  template <std::size_t I> const column_type<I> &column() const {
+    return std::get<I>(m_cols);
+  }
+  template <std::size_t I> field_type<I> *data() const {
+    return std::get<I>(m_cols).data();
+  }
+
+  // Element access
+  Row operator[](std::size_t p_i) {
+    if (p_i < size())
+      return Row(this, p_i);
+    throw std::out_of_range("Out of range");
+  }
+  Row at(std::size_t p_i) { return operator[](p_i); }
+
+  template <std::size_t I> field_type<I> &get(std::size_t p_i) {
+    return std::get<I>(m_cols)[p_i];
+  }
+  template <std::size_t I> const field_type<I> &get(std::size_t p_i) const {
+    return std::get<I>(m_cols)[p_i];
+  }
+
+  Row front() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return Row(this, 0);
+  }
+
+  Row back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    return Row(this, size() - 1);
+  }
+
+  // Modifiers
+  void push_back(const value_type &p_val) {
+    push_back_impl(p_val, std::index_sequence_for<Fields...>{});
+  }
+  void push_back(const Fields &...p_fields) {
+    push_back_impl(std::forward_as_tuple(p_fields...),
+                   std::index_sequence_for<Fields...>{});
+  }
+
+  void pop_back() {
+    if (empty())
+      throw std::out_of_range("Empty");
+    for_each_column([](auto &col) { col.pop_back(); });
+  }
+
+  // Iterator
+  Iterator begin() { return Iterator(this, 0); }
+  Iterator end() { return Iterator(this, size()); }
+
+private:
+  template <typename F> void for_each_column(F p_fn) {
+    for_each_column(p_fn, std::index_sequence_for<Fields...>{});
+  }
+  template <typename F, std::size_t... Is>
+  void for_each_column(F &p_fn, std::index_sequence<Is...>) {
+    int expand[] = {0, (p_fn(std::get<Is>(m_cols)), 0)...};
+    (void)expand;
+  }
+
+  template <typename Tuple, std::size_t... Is>
+  void push_back_impl(const Tuple &p_val, std::index_sequence<Is...>) {
+    int expand[] = {0, (std::get<Is>(m_cols).push_back(std::get<Is>(p_val)),
+                        0)...};
+    (void)expand;
+  }
+
+  template <std::size_t... Is>
+  void assign(std::size_t p_i, const value_type &p_val,
+              std::index_sequence<Is...>) {
+    int expand[] = {0, (data<Is>()[p_i] = std::get<Is>(p_val), 0)...};
+    (void)expand;
+  }
+
+  template <std::size_t... Is>
+  value_type gather(std::size_t p_i, std::index_sequence<Is...>) const {
+    return value_type(data<Is>()[p_i]...);
+  }
+};
+
+} // namespace tlib
+
+#endif // TLIB_SOA_VECTOR_H
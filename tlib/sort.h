@@ -0,0 +1,240 @@
+#ifndef TLIB_SORT_H
+#define TLIB_SORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "tlib/vector.h"
+
+// Arrays up to this size are sorted with a sorting network
+#define _SORT_NETWORK_MAX 32
+
+namespace tlib {
+
+// Maps an arithmetic key to an unsigned integer with the same ordering, so
+// that radix sort can work on its bytes.
+template <typename T, typename Enable = void> struct RadixKey;
+
+template <typename T>
+struct RadixKey<T, typename std::enable_if<std::is_integral<T>::value &&
+                                           std::is_unsigned<T>::value>::type> {
+  using type = T;
+  static type get(T p_val) { return p_val; }
+};
+
+// Signed integers: flip the sign bit
+template <typename T>
+struct RadixKey<T, typename std::enable_if<std::is_integral<T>::value &&
+                                           std::is_signed<T>::value>::type> {
+  using type = typename std::make_unsigned<T>::type;
+  static type get(T p_val) {
+    return static_cast<type>(p_val) ^
+           (type(1) << (std::numeric_limits<type>::digits - 1));
+  }
+};
+
+// IEEE floats: flip all bits of negatives, only the sign bit of positives
+template <> struct RadixKey<float> {
+  using type = std::uint32_t;
+  static type get(float p_val) {
+    type u;
+    std::memcpy(&u, &p_val, sizeof(u));
+    return u ^ (-(u >> 31) | 0x80000000u);
+  }
+  static float from(type p_key) {
+    const type u = p_key ^ (((p_key >> 31) - 1) | 0x80000000u);
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+  }
+};
+
+template <> struct RadixKey<double> {
+  using type = std::uint64_t;
+  static type get(double p_val) {
+    type u;
+    std::memcpy(&u, &p_val, sizeof(u));
+    return u ^ (-(u >> 63) | 0x8000000000000000ull);
+  }
+  static double from(type p_key) {
+    const type u = p_key ^ (((p_key >> 63) - 1) | 0x8000000000000000ull);
+    double d;
+    std::memcpy(&d, &u, sizeof(d));
+    return d;
+  }
+};
+
+namespace sort_detail {
+
+// Compare-exchange written so that it always keeps both values, even when
+// they are unordered
+template <typename T> void compare_exchange(T &p_a, T &p_b) {
+  const T lo = p_b < p_a ? p_b : p_a;
+  const T hi = p_b < p_a ? p_a : p_b;
+  p_a = lo;
+  p_b = hi;
+}
+
+// Bitonic network. The inner loops run over contiguous elements, so for
+// integers the compiler can lower the compare-exchanges to SIMD min/max
+// instructions.
+template <typename T>
+void network_sort(T *p_data, std::size_t p_n, std::false_type) {
+  T buf[_SORT_NETWORK_MAX];
+  std::size_t m = 1;
+  while (m < p_n)
+    m *= 2;
+  const T pad = std::numeric_limits<T>::has_infinity
+                    ? std::numeric_limits<T>::infinity()
+                    : std::numeric_limits<T>::max();
+  for (std::size_t i = 0; i < m; ++i)
+    buf[i] = i < p_n ? p_data[i] : pad;
+
+  for (std::size_t k = 2; k <= m; k *= 2) {
+    // Compare mirrored pairs, which merges two sorted halves into a bitonic
+    // sequence without reversing either of them
+    for (std::size_t b = 0; b < m; b += k) {
+      for (std::size_t i = 0; i < k / 2; ++i)
+        compare_exchange(buf[b + i], buf[b + k - 1 - i]);
+    }
+    for (std::size_t j = k / 4; j > 0; j /= 2) {
+      for (std::size_t b = 0; b < m; b += 2 * j) {
+        for (std::size_t i = 0; i < j; ++i)
+          compare_exchange(buf[b + i], buf[b + i + j]);
+      }
+    }
+  }
+
+  std::copy(buf, buf + p_n, p_data);
+}
+
+// float and double go through their radix keys, so that small inputs get
+// the same order as the radix path: -0.0 before 0.0, and NaNs at the ends
+// by sign bit.
+template <typename T>
+void network_sort(T *p_data, std::size_t p_n, std::true_type) {
+  using K = typename RadixKey<T>::type;
+  K keys[_SORT_NETWORK_MAX];
+  for (std::size_t i = 0; i < p_n; ++i)
+    keys[i] = RadixKey<T>::get(p_data[i]);
+  network_sort(keys, p_n, std::false_type{});
+  for (std::size_t i = 0; i < p_n; ++i)
+    p_data[i] = RadixKey<T>::from(keys[i]);
+}
+
+} // namespace sort_detail
+
+// Sorting network for at most _SORT_NETWORK_MAX arithmetic values. The input
+// is padded to a power of two and sorted with a bitonic network.
+template <typename T> void network_sort(T *p_data, std::size_t p_n) {
+  static_assert(std::is_arithmetic<T>::value,
+                "network_sort needs an arithmetic type");
+  if (p_n > _SORT_NETWORK_MAX)
+    throw std::length_error("Too many elements for a sorting network");
+  sort_detail::network_sort(
+      p_data, p_n,
+      std::integral_constant<bool, std::is_same<T, float>::value ||
+                                       std::is_same<T, double>::value>{});
+}
+
+// LSD radix sort on the bytes of p_key(element), which must return an
+// unsigned integer. Stable. p_tmp must have room for p_n elements. Passes
+// where every key has the same byte are skipped.
+template <typename T, typename KeyFn>
+void radix_sort(T *p_data, T *p_tmp, std::size_t p_n, KeyFn p_key) {
+  using K = typename std::decay<decltype(p_key(*p_data))>::type;
+  static_assert(std::is_unsigned<K>::value, "Radix keys must be unsigned");
+  constexpr std::size_t passes = sizeof(K);
+
+  if (p_n < 2)
+    return;
+
+  // One read of the input builds the histograms of all passes
+  std::size_t counts[passes][256] = {};
+  for (std::size_t i = 0; i < p_n; ++i) {
+    const K k = p_key(p_data[i]);
+    for (std::size_t p = 0; p < passes; ++p)
+      ++counts[p][static_cast<std::size_t>(k >> (8 * p)) & 0xff];
+  }
+
+  T *src = p_data;
+  T *dst = p_tmp;
+  for (std::size_t p = 0; p < passes; ++p) {
+    std::size_t *c = counts[p];
+    if (c[static_cast<std::size_t>(p_key(src[0]) >> (8 * p)) & 0xff] == p_n)
+      continue;
+
+    std::size_t sum = 0;
+    for (std::size_t d = 0; d < 256; ++d) {
+      const std::size_t cnt = c[d];
+      c[d] = sum;
+      sum += cnt;
+    }
+    for (std::size_t i = 0; i < p_n; ++i) {
+      const K k = p_key(src[i]);
+      dst[c[static_cast<std::size_t>(k >> (8 * p)) & 0xff]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+
+  if (src != p_data)
+    std::copy(src, src + p_n, p_data);
+}
+
+// Sort a Vector of integers or floating point values. p_scratch is resized
+// to the input size and can be reused across calls to avoid reallocating.
+template <typename T> void radix_sort(Vector<T> &p_vec, Vector<T> &p_scratch) {
+  const std::size_t n = p_vec.size();
+  if (n <= _SORT_NETWORK_MAX) {
+    network_sort(p_vec.data(), n);
+    return;
+  }
+  p_scratch.resize(n);
+  radix_sort(p_vec.data(), p_scratch.data(), n,
+             [](const T &p_val) { return RadixKey<T>::get(p_val); });
+}
+
+template <typename T> void radix_sort(Vector<T> &p_vec) {
+  Vector<T> scratch(0);
+  radix_sort(p_vec, scratch);
+}
+
+// Stable sort of arbitrary elements by an arithmetic key, e.g. a struct
+// field. Small inputs use insertion sort on the same radix keys, so both
+// paths order -0.0 before 0.0 and NaNs at the ends by sign bit.
+template <typename T, typename KeyFn>
+void radix_sort_by_key(Vector<T> &p_vec, Vector<T> &p_scratch, KeyFn p_key) {
+  using K = typename std::decay<decltype(p_key(*p_vec.data()))>::type;
+  const std::size_t n = p_vec.size();
+  T *data = p_vec.data();
+  if (n <= _SORT_NETWORK_MAX) {
+    for (std::size_t i = 1; i < n; ++i) {
+      T tmp = data[i];
+      const auto k = RadixKey<K>::get(p_key(tmp));
+      std::size_t j = i;
+      for (; j > 0 && k < RadixKey<K>::get(p_key(data[j - 1])); --j)
+        data[j] = data[j - 1];
+      data[j] = tmp;
+    }
+    return;
+  }
+  p_scratch.resize(n);
+  radix_sort(data, p_scratch.data(), n, [&p_key](const T &p_val) {
+    return RadixKey<K>::get(p_key(p_val));
+  });
+}
+
+template <typename T, typename KeyFn>
+void radix_sort_by_key(Vector<T> &p_vec, KeyFn p_key) {
+  Vector<T> scratch(0);
+  radix_sort_by_key(p_vec, scratch, p_key);
+}
+
+} // namespace tlib
+
+#endif // TLIB_SORT_H
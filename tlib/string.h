@@ -3,29 +3,47 @@
 
 #include <cstring>
 #include <stdexcept>
+#include <type_traits>
+
+#include "tlib/charconv.h"
 
 namespace tlib {
 
 class String {
 private:
   char *m_buf;
-  String() : m_buf(nullptr){}; // Private default constructor
+  std::size_t m_len; // characters before the terminator
+  std::size_t m_cap; // characters that fit before the terminator
+  // Private default constructor
+  String() : m_buf(nullptr), m_len(0), m_cap(0){};
 
 public:
   // Constructor
   String(const char *p_src) {
     if (p_src) {
-      m_buf = new char[std::strlen(p_src) + 1];
+      m_len = m_cap = std::strlen(p_src);
+      m_buf = new char[m_cap + 1];
       std::strcpy(m_buf, p_src);
-    } else
+    } else {
       m_buf = nullptr;
+      m_len = m_cap = 0;
+    }
   };
 
+  // Fill constructor
+  String(std::size_t p_count, char p_ch) : m_len(p_count), m_cap(p_count) {
+    m_buf = new char[p_count + 1];
+    std::memset(m_buf, p_ch, p_count);
+    m_buf[p_count] = '\0';
+  }
+
   // Move constructor
-  String(String &&p_move_src) {
+  String(String &&p_move_src)
+      : m_len(p_move_src.m_len), m_cap(p_move_src.m_cap) {
     if (p_move_src.m_buf) {
       m_buf = p_move_src.m_buf;
       p_move_src.m_buf = nullptr;
+      p_move_src.m_len = p_move_src.m_cap = 0;
     } else
       m_buf = nullptr;
   };
@@ -37,7 +55,10 @@ public:
         delete[] m_buf; // free own buf
 
       m_buf = p_move_src.m_buf;   // move resource
+      m_len = p_move_src.m_len;
+      m_cap = p_move_src.m_cap;
       p_move_src.m_buf = nullptr; // free source
+      p_move_src.m_len = p_move_src.m_cap = 0;
     }
     return *this;
   }
@@ -45,10 +66,13 @@ public:
   // Copy constructor
   String(const String &p_copy_src) {
     if (p_copy_src.m_buf) {
-      m_buf = new char[std::strlen(p_copy_src.m_buf) + 1];
+      m_len = m_cap = std::strlen(p_copy_src.m_buf);
+      m_buf = new char[m_cap + 1];
       std::strcpy(m_buf, p_copy_src.m_buf);
-    } else
+    } else {
       m_buf = nullptr;
+      m_len = m_cap = 0;
+    }
   }
 
   // Copy assignment operator
@@ -57,7 +81,8 @@ public:
       if (m_buf)
         delete[] m_buf; // free own buffer
 
-      m_buf = new char[std::strlen(p_copy_src.m_buf) + 1];
+      m_len = m_cap = std::strlen(p_copy_src.m_buf);
+      m_buf = new char[m_cap + 1];
       std::strcpy(m_buf, p_copy_src.m_buf);
     }
 
@@ -71,15 +96,15 @@ public:
   }
 
   // Get size
-  int size() const {
-    if (m_buf)
-      return std::strlen(m_buf);
-    return 0;
-  }
+  int size() const { return static_cast<int>(m_len); }
 
   // Casting operator
   operator const char *() { return m_buf; }
 
+  // Buffer access
+  const char *c_str() const { return m_buf; }
+  char *data() { return m_buf; }
+
   // Equality
   bool operator==(const String &p_other) const {
     return std::strcmp(m_buf, p_other.m_buf) == 0;
@@ -95,7 +120,8 @@ public:
   String operator+(const String &p_other) {
     String res;
     if (p_other.m_buf) {
-      res.m_buf = new char[std::strlen(m_buf) + std::strlen(p_other.m_buf) + 1];
+      res.m_len = res.m_cap = std::strlen(m_buf) + std::strlen(p_other.m_buf);
+      res.m_buf = new char[res.m_cap + 1];
       std::strcpy(res.m_buf, m_buf);
       std::strcat(res.m_buf, p_other.m_buf);
     }
@@ -103,6 +129,37 @@ public:
     return res;
   }
 
+  // Number formatting. Digits are written straight into the buffer, which
+  // grows geometrically, so building a line of numbers is linear.
+  template <typename T> String &append_int(T p_val) {
+    write_int(extend(int_length(p_val)), p_val);
+    return *this;
+  }
+
+  // Shortest text that reads back as the same value
+  String &append_float(double p_val) {
+    char tmp[_FLOAT_CHARS];
+    const std::size_t n = write_double(tmp, p_val) - tmp;
+    std::memcpy(extend(n), tmp, n);
+    return *this;
+  }
+  String &append_float(float p_val) {
+    char tmp[_FLOAT_CHARS];
+    const std::size_t n = write_float(tmp, p_val) - tmp;
+    std::memcpy(extend(n), tmp, n);
+    return *this;
+  }
+  // Integers and other arithmetic types are formatted as double
+  template <typename T, typename = typename std::enable_if<
+                            std::is_arithmetic<T>::value>::type>
+  String &append_float(T p_val) {
+    return append_float(static_cast<double>(p_val));
+  }
+
+  // Number parsing. The whole string must be a number.
+  long long parse_int() const { return tlib::parse_int(m_buf); }
+  double parse_float() const { return parse_double(m_buf); }
+
   // Subscript operator
   char &operator[](int i) {
     if (i < size()) {
@@ -110,6 +167,27 @@ public:
     } else
       throw std::out_of_range("Out of range");
   }
+
+private:
+  // Lengthen the string by p_extra characters and return where they start.
+  // Reallocates only when the capacity runs out, at least doubling it.
+  char *extend(std::size_t p_extra) {
+    const std::size_t len = m_len;
+    if (len + p_extra > m_cap) {
+      const std::size_t cap =
+          len + p_extra > 2 * m_cap ? len + p_extra : 2 * m_cap;
+      char *buf = new char[cap + 1];
+      if (m_buf) {
+        std::memcpy(buf, m_buf, len);
+        delete[] m_buf;
+      }
+      m_buf = buf;
+      m_cap = cap;
+    }
+    m_len = len + p_extra;
+    m_buf[m_len] = '\0';
+    return m_buf + len;
+  }
 };
 
 } // namespace tlib
@@ -3,6 +3,7 @@
 
 #include <initializer_list>
 #include <stdexcept>
+#include <utility>
 
 #include "tlib/iterator.h"
 
@@ -112,6 +113,14 @@ public:
     m_space = m_buf + p_sz;
   }
 
+  // Like resize(), but a reallocation at least doubles the capacity, so
+  // growing a little at a time stays amortized linear
+  void grow(std::size_t p_sz) {
+    if (p_sz > capacity())
+      reserve(p_sz > 2 * capacity() ? p_sz : 2 * capacity());
+    resize(p_sz);
+  }
+
   void reserve(std::size_t p_sz) { // Increase capacity to newsz
     if (p_sz > capacity()) {
       auto *new_buf = new T[p_sz];
@@ -156,11 +165,17 @@ public:
   }
 
   // Modifiers
+  // Slots past size() are already constructed by new T[], so assign into
+  // them. el may be an element of this Vector, so copy it before reserve()
+  // frees the buffer.
   void push_back(const T &el) {
     if (size() + 1 > capacity()) {
+      T val = el;
       reserve(size() == 0 ? _MIN_SZ : size() * 2);
+      *m_space = std::move(val);
+    } else {
+      *m_space = el;
     }
-    new (m_space) T{el};
     m_space++;
   }
 